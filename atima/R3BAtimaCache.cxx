@@ -16,11 +16,88 @@
 #include "FairLogger.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <dirent.h>
 #include <exception>
-#include <fstream>
 #include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
 
-constexpr UInt_t MagicWord = 0xF0F00000;
+namespace
+{
+    UInt_t gNumberOfWorkers = 1;
+
+    // A child forked from a process with several threads may deadlock on a
+    // lock held by another thread, e.g. in malloc or ROOT
+    Bool_t isSingleThreaded()
+    {
+        DIR* dir = opendir("/proc/self/task");
+        if (!dir)
+            return kFALSE;
+        Int_t nThreads = 0;
+        while (const dirent* entry = readdir(dir))
+            if (entry->d_name[0] != '.')
+                ++nThreads;
+        closedir(dir);
+        return nThreads == 1;
+    }
+
+    // FNV-1a
+    ULong64_t hashBytes(const void* data, const size_t size, ULong64_t hash = 14695981039346656037ULL)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ULL;
+        }
+        return hash;
+    }
+
+    // Grid point below value and the distance from it [steps]
+    void findNode(const R3BAtima::Cache::RangeSelector& range, const Double_t value, Int_t& index, Double_t& frac)
+    {
+        if (range.Steps <= 0)
+        {
+            index = 0;
+            frac = 0.;
+            return;
+        }
+        const Double_t pos = (value - range.MinValue) / (range.MaxValue - range.MinValue) * range.Steps;
+        // Clamp before the conversion, which is undefined for values out of the range of Int_t and NaN
+        const Double_t node = std::isnan(pos) ? 0. : std::min(std::max(pos, 0.), Double_t(range.Steps - 1));
+        index = Int_t(node);
+        frac = pos - index;
+    }
+
+    // Catmull-Rom weights of the grid points index - 1 ... index + 2. Points
+    // outside the grid are extrapolated linearly from the two nearest ones.
+    void cubicWeights(const Double_t t, const Int_t index, const Int_t steps, Double_t w[4])
+    {
+        const Double_t t2 = t * t;
+        const Double_t t3 = t2 * t;
+        w[0] = 0.5 * (-t3 + 2. * t2 - t);
+        w[1] = 0.5 * (3. * t3 - 5. * t2 + 2.);
+        w[2] = 0.5 * (-3. * t3 + 4. * t2 + t);
+        w[3] = 0.5 * (t3 - t2);
+        if (index - 1 < 0)
+        {
+            w[1] += 2. * w[0];
+            w[2] -= w[0];
+            w[0] = 0.;
+        }
+        if (index + 2 > steps)
+        {
+            w[2] += 2. * w[3];
+            w[1] -= w[3];
+            w[3] = 0.;
+        }
+    }
+} // namespace
 
 namespace R3BAtima
 {
@@ -35,6 +112,7 @@ namespace R3BAtima
         , fEnergies(energies_MeV_per_u)
         , fTargetMaterial(targetMaterial)
         , fDistances(distances_mm)
+        , fInterpolation(Interpolation::Bilinear)
     {
         calculate();
     }
@@ -50,282 +128,290 @@ namespace R3BAtima
         , fEnergies(energies_MeV_per_u)
         , fTargetMaterial(targetMaterial)
         , fDistances(distances_mm)
+        , fInterpolation(Interpolation::Bilinear)
     {
-        if (!read(path))
+        TString fileName = path;
+        struct stat status;
+        if (stat(path.Data(), &status) == 0 && S_ISDIR(status.st_mode))
+            fileName = TString::Format("%s/atima_%016llx.cache", path.Data(), GetKey());
+
+        if (read(fileName))
+            return;
+
+        // Another job may be creating the same file, wait for it
+        const auto lock = CacheFile::Lock(fileName.Data());
+        if (!read(fileName))
         {
-            LOG(INFO) << "AtimaCache-File '" << path
+            LOG(INFO) << "AtimaCache-File '" << fileName
                       << "' does not exist or does not match the provided Data! Will (re)calculate and (over)write!";
 
-            fProjMass = pMass_u;
-            fProjCharge = pCharge_e;
-            fEnergies = energies_MeV_per_u;
-            fTargetMaterial = targetMaterial;
-            fDistances = distances_mm;
-
             calculate();
-            write(path);
+            write(fileName);
         }
+        CacheFile::Unlock(fileName.Data(), lock);
     }
 
-    TransportResult Cache::operator()(const Double_t energy_MeV_per_u, const Double_t distance_mm) const
+    ULong64_t Cache::GetKey() const
     {
+        const auto h = header();
+        const auto c = compounds();
+        return hashBytes(c.data(), c.size() * sizeof(Double_t), hashBytes(&h, sizeof(h)));
+    }
 
-        if (energy_MeV_per_u < fEnergies.MinValue || energy_MeV_per_u > fEnergies.MaxValue ||
-            distance_mm < fDistances.MinValue || distance_mm > fDistances.MaxValue)
-            LOG(FATAL) << "R3BAtima::Cache: given value outside of calculated range!";
+    void Cache::SetNumberOfWorkers(const UInt_t nWorkers) { gNumberOfWorkers = nWorkers; }
 
+    TransportResult Cache::operator()(const Double_t energy_MeV_per_u, const Double_t distance_mm) const
+    {
         TransportResult res;
-
-        res.EnergyIn_MeV_per_u = energy_MeV_per_u;
-        res.ELoss_MeV_per_u = fG_ELoss.Interpolate(energy_MeV_per_u, distance_mm);
-        res.EnergyOut_MeV_per_u = res.EnergyIn_MeV_per_u - res.ELoss_MeV_per_u;
-        res.EStrag_MeV_per_u = fG_EStrag.Interpolate(energy_MeV_per_u, distance_mm);
-        res.AngStrag_mRad = fG_AngStrag.Interpolate(energy_MeV_per_u, distance_mm);
-        res.Range_mg_per_cm2 = fG_Range.Interpolate(energy_MeV_per_u, distance_mm);
-        res.RemainingRange_mg_per_cm2 = fG_RemainigRange.Interpolate(energy_MeV_per_u, distance_mm);
-        res.dEdXIn_MeVcm2_per_mg = fG_dEdXIn.Interpolate(energy_MeV_per_u, distance_mm);
-        res.dEdXOut_MeVcm2_per_mg = fG_dEdXOut.Interpolate(energy_MeV_per_u, distance_mm);
-        res.ToF_ns = fG_ToF.Interpolate(energy_MeV_per_u, distance_mm);
-        res.InterpolatedTargetThickness = fG_InterpolatedTargetThickness.Interpolate(energy_MeV_per_u, distance_mm);
-
+        evaluate(energy_MeV_per_u, distance_mm, res);
         return res;
     }
 
-    Bool_t Cache::read(const TString& path)
+    void Cache::operator()(const Int_t n,
+                           const Double_t* energies_MeV_per_u,
+                           const Double_t* distances_mm,
+                           TransportResult* results) const
     {
-        std::ifstream fstream(path.Data(), std::ifstream::binary);
-
-        if (!fstream.good())
-            return kFALSE;
-
-        UInt_t Version;
-        fstream.read(reinterpret_cast<char*>(&Version), sizeof(Version));
-        if (Version != MagicWord)
-            return kFALSE;
-
-        Double_t projM, projCharge;
-
-        fstream.read(reinterpret_cast<char*>(&projM), sizeof(projM));
-        fstream.read(reinterpret_cast<char*>(&projCharge), sizeof(projCharge));
+        for (Int_t i = 0; i < n; ++i)
+            evaluate(energies_MeV_per_u[i], distances_mm[i], results[i]);
+    }
 
-        if (projM != fProjMass || projCharge != fProjCharge)
-            return kFALSE;
+    void Cache::evaluate(const Double_t energy_MeV_per_u, const Double_t distance_mm, TransportResult& res) const
+    {
+        if (energy_MeV_per_u < fEnergies.MinValue || energy_MeV_per_u > fEnergies.MaxValue ||
+            distance_mm < fDistances.MinValue || distance_mm > fDistances.MaxValue)
+            LOG(FATAL) << "R3BAtima::Cache: given value outside of calculated range!";
 
-        Double_t mass, charge, ratio;
+        Int_t iE, iD;
+        Double_t tE, tD;
+        findNode(fEnergies, energy_MeV_per_u, iE, tE);
+        findNode(fDistances, distance_mm, iD, tD);
 
-        Int_t nComps;
-        fstream.read(reinterpret_cast<char*>(&nComps), sizeof(nComps));
+        const Int_t strideD = kNQuantities;
+        const Int_t strideE = (fDistances.Steps + 1) * strideD;
 
-        if (nComps != fTargetMaterial.Compounds.size())
-            return kFALSE;
+        Double_t values[kNQuantities];
 
-        for (auto i = 0; i < nComps; ++i)
+        if (fInterpolation == Interpolation::Bicubic)
         {
-            fstream.read(reinterpret_cast<char*>(&mass), sizeof(mass));
-            fstream.read(reinterpret_cast<char*>(&charge), sizeof(charge));
-            fstream.read(reinterpret_cast<char*>(&ratio), sizeof(ratio));
+            Double_t wE[4], wD[4];
+            cubicWeights(tE, iE, fEnergies.Steps, wE);
+            cubicWeights(tD, iD, fDistances.Steps, wD);
 
-            if (fTargetMaterial.Compounds[i].Mass_u != mass || fTargetMaterial.Compounds[i].Charge_e != charge ||
-                fTargetMaterial.Compounds[i].Ratio != ratio)
-                return kFALSE;
+            std::fill(values, values + kNQuantities, 0.);
+            for (Int_t k = 0; k < 4; ++k)
+            {
+                if (wE[k] == 0.)
+                    continue;
+                const Int_t e = std::min(std::max(iE - 1 + k, 0), fEnergies.Steps);
+                for (Int_t l = 0; l < 4; ++l)
+                {
+                    if (wD[l] == 0.)
+                        continue;
+                    const Int_t d = std::min(std::max(iD - 1 + l, 0), fDistances.Steps);
+                    const Double_t w = wE[k] * wD[l];
+                    const Double_t* p = table() + e * strideE + d * strideD;
+                    for (Int_t q = 0; q < kNQuantities; ++q)
+                        values[q] += w * p[q];
+                }
+            }
+        }
+        else
+        {
+            // A range with zero steps has a single grid point
+            const Double_t* p00 = table() + iE * strideE + iD * strideD;
+            const Double_t* p01 = p00 + (fDistances.Steps > 0 ? strideD : 0);
+            const Double_t* p10 = p00 + (fEnergies.Steps > 0 ? strideE : 0);
+            const Double_t* p11 = p10 + (p01 - p00);
+
+            for (Int_t q = 0; q < kNQuantities; ++q)
+                values[q] = (1. - tE) * ((1. - tD) * p00[q] + tD * p01[q]) + tE * ((1. - tD) * p10[q] + tD * p11[q]);
         }
 
-        Double_t minVal, maxVal;
-        Int_t steps;
-
-        fstream.read(reinterpret_cast<char*>(&minVal), sizeof(minVal));
-        fstream.read(reinterpret_cast<char*>(&maxVal), sizeof(maxVal));
-        fstream.read(reinterpret_cast<char*>(&steps), sizeof(steps));
-
-        if (minVal != fEnergies.MinValue || maxVal != fEnergies.MaxValue || steps != fEnergies.Steps)
-            return kFALSE;
-
-        fstream.read(reinterpret_cast<char*>(&minVal), sizeof(minVal));
-        fstream.read(reinterpret_cast<char*>(&maxVal), sizeof(maxVal));
-        fstream.read(reinterpret_cast<char*>(&steps), sizeof(steps));
-
-        if (minVal != fDistances.MinValue || maxVal != fDistances.MaxValue || steps != fDistances.Steps)
-            return kFALSE;
-
-        Double_t density;
-        Bool_t isGas;
+        res.EnergyIn_MeV_per_u = energy_MeV_per_u;
+        res.ELoss_MeV_per_u = values[kELoss];
+        res.EnergyOut_MeV_per_u = res.EnergyIn_MeV_per_u - res.ELoss_MeV_per_u;
+        res.EStrag_MeV_per_u = values[kEStrag];
+        res.AngStrag_mRad = values[kAngStrag];
+        res.Range_mg_per_cm2 = values[kRange];
+        res.RemainingRange_mg_per_cm2 = values[kRemainingRange];
+        res.dEdXIn_MeVcm2_per_mg = values[kdEdXIn];
+        res.dEdXOut_MeVcm2_per_mg = values[kdEdXOut];
+        res.ToF_ns = values[kToF];
+        res.InterpolatedTargetThickness = values[kInterpolatedTargetThickness];
+    }
 
-        fstream.read(reinterpret_cast<char*>(&density), sizeof(density));
-        fstream.read(reinterpret_cast<char*>(&isGas), sizeof(isGas));
+    void Cache::resize()
+    {
+        fTable.assign(size_t(fEnergies.Steps + 1) * (fDistances.Steps + 1) * kNQuantities, 0.);
+    }
 
-        if (density != fTargetMaterial.Density || isGas != fTargetMaterial.IsGas)
-            return kFALSE;
+    CacheFile::Header Cache::header() const
+    {
+        // Zero everything not describing the cache, including magic and version
+        CacheFile::Header h;
+        memset(&h, 0, sizeof(h));
+        h.fProjMass = fProjMass;
+        h.fProjCharge = fProjCharge;
+        h.fEnergyMin = fEnergies.MinValue;
+        h.fEnergyMax = fEnergies.MaxValue;
+        h.fEnergySteps = fEnergies.Steps;
+        h.fDistanceMin = fDistances.MinValue;
+        h.fDistanceMax = fDistances.MaxValue;
+        h.fDistanceSteps = fDistances.Steps;
+        h.fDensity = fTargetMaterial.Density;
+        h.fIsGas = fTargetMaterial.IsGas ? 1 : 0;
+        h.fNCompounds = fTargetMaterial.Compounds.size();
+        h.fNQuantities = kNQuantities;
+        return h;
+    }
 
-        const auto maxStep = (fEnergies.Steps + 1) * (fDistances.Steps + 1);
-
-        fG_ELoss.Set(maxStep);
-        fG_EStrag.Set(maxStep);
-        fG_AngStrag.Set(maxStep);
-        fG_Range.Set(maxStep);
-        fG_RemainigRange.Set(maxStep);
-        fG_dEdXIn.Set(maxStep);
-        fG_dEdXOut.Set(maxStep);
-        fG_ToF.Set(maxStep);
-        fG_InterpolatedTargetThickness.Set(maxStep);
-
-        Int_t nPoints = 0;
-        Double_t energy = fEnergies.MinValue;
-        for (int i = 0; i <= fEnergies.Steps; ++i)
+    std::vector<Double_t> Cache::compounds() const
+    {
+        std::vector<Double_t> c;
+        for (const auto& comp : fTargetMaterial.Compounds)
         {
-            Double_t distance = fDistances.MinValue;
-            for (int j = 0; j <= fDistances.Steps; ++j)
-            {
-
-                TransportResult res;
-
-                fstream.read(reinterpret_cast<char*>(&res.ELoss_MeV_per_u), sizeof(res.ELoss_MeV_per_u));
-                fstream.read(reinterpret_cast<char*>(&res.EStrag_MeV_per_u), sizeof(res.EStrag_MeV_per_u));
-                fstream.read(reinterpret_cast<char*>(&res.AngStrag_mRad), sizeof(res.AngStrag_mRad));
-                fstream.read(reinterpret_cast<char*>(&res.Range_mg_per_cm2), sizeof(res.Range_mg_per_cm2));
-                fstream.read(reinterpret_cast<char*>(&res.RemainingRange_mg_per_cm2),
-                             sizeof(res.RemainingRange_mg_per_cm2));
-                fstream.read(reinterpret_cast<char*>(&res.dEdXIn_MeVcm2_per_mg), sizeof(res.dEdXIn_MeVcm2_per_mg));
-                fstream.read(reinterpret_cast<char*>(&res.dEdXOut_MeVcm2_per_mg), sizeof(res.dEdXOut_MeVcm2_per_mg));
-                fstream.read(reinterpret_cast<char*>(&res.ToF_ns), sizeof(res.ToF_ns));
-                fstream.read(reinterpret_cast<char*>(&res.InterpolatedTargetThickness),
-                             sizeof(res.InterpolatedTargetThickness));
-
-                fG_ELoss.SetPoint(nPoints, energy, distance, res.ELoss_MeV_per_u);
-                fG_EStrag.SetPoint(nPoints, energy, distance, res.EStrag_MeV_per_u);
-                fG_AngStrag.SetPoint(nPoints, energy, distance, res.AngStrag_mRad);
-                fG_Range.SetPoint(nPoints, energy, distance, res.Range_mg_per_cm2);
-                fG_RemainigRange.SetPoint(nPoints, energy, distance, res.RemainingRange_mg_per_cm2);
-                fG_dEdXIn.SetPoint(nPoints, energy, distance, res.dEdXIn_MeVcm2_per_mg);
-                fG_dEdXOut.SetPoint(nPoints, energy, distance, res.dEdXOut_MeVcm2_per_mg);
-                fG_ToF.SetPoint(nPoints, energy, distance, res.ToF_ns);
-                fG_InterpolatedTargetThickness.SetPoint(nPoints, energy, distance, res.InterpolatedTargetThickness);
-
-                ++nPoints;
-                distance += (fDistances.MaxValue - fDistances.MinValue) / fDistances.Steps;
-            }
-            energy += (fEnergies.MaxValue - fEnergies.MinValue) / fEnergies.Steps;
+            c.push_back(comp.Mass_u);
+            c.push_back(comp.Charge_e);
+            c.push_back(comp.Ratio);
         }
+        return c;
+    }
 
-        if (!fstream.good())
+    Bool_t Cache::read(const TString& fileName)
+    {
+        auto file = std::make_shared<CacheFile>();
+        if (!file->Open(fileName.Data()))
             return kFALSE;
 
-        Version = 0;
-
-        fstream.read(reinterpret_cast<char*>(&Version), sizeof(Version));
-
-        if (Version != MagicWord)
+        auto h = file->GetHeader();
+        const auto key = h.fKey;
+        memset(h.fMagic, 0, sizeof(h.fMagic));
+        h.fVersion = 0;
+        h.fHeaderSize = 0;
+        h.fKey = 0;
+
+        const auto expected = header();
+        const auto c = compounds();
+        if (key != GetKey() || memcmp(&h, &expected, sizeof(h)) != 0 ||
+            memcmp(file->GetCompounds(), c.data(), c.size() * sizeof(Double_t)) != 0)
             return kFALSE;
 
+        fFile = file;
+        fTable.clear();
         return kTRUE;
     }
 
-    void Cache::write(const TString& path) const
+    void Cache::write(const TString& fileName) const
     {
-        std::ofstream fstream(path.Data(), std::ofstream::binary | std::ofstream::trunc);
+        auto h = header();
+        h.fKey = GetKey();
+        CacheFile::Write(fileName.Data(), h, compounds().data(), table());
+    }
 
-        UInt_t Version = MagicWord;
-        fstream.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
+    void Cache::calculateRow(const Int_t iEnergy, Double_t* row) const
+    {
+        // The table is looked up at exactly these grid points
+        const auto energy =
+            fEnergies.Steps > 0
+                ? fEnergies.MinValue + iEnergy * (fEnergies.MaxValue - fEnergies.MinValue) / fEnergies.Steps
+                : fEnergies.MinValue;
+        for (int j = 0; j <= fDistances.Steps; ++j)
+        {
+            const auto distance =
+                fDistances.Steps > 0
+                    ? fDistances.MinValue + j * (fDistances.MaxValue - fDistances.MinValue) / fDistances.Steps
+                    : fDistances.MinValue;
+            auto res = Calculate_mm(fProjMass, fProjCharge, energy, fTargetMaterial, distance);
+
+            auto p = row + j * kNQuantities;
+            p[kELoss] = res.ELoss_MeV_per_u;
+            p[kEStrag] = res.EStrag_MeV_per_u;
+            p[kAngStrag] = res.AngStrag_mRad;
+            p[kRange] = res.Range_mg_per_cm2;
+            p[kRemainingRange] = res.RemainingRange_mg_per_cm2;
+            p[kdEdXIn] = res.dEdXIn_MeVcm2_per_mg;
+            p[kdEdXOut] = res.dEdXOut_MeVcm2_per_mg;
+            p[kToF] = res.ToF_ns;
+            p[kInterpolatedTargetThickness] = res.InterpolatedTargetThickness;
+        }
+    }
 
-        fstream.write(reinterpret_cast<const char*>(&fProjMass), sizeof(fProjMass));
-        fstream.write(reinterpret_cast<const char*>(&fProjCharge), sizeof(fProjCharge));
+    void Cache::calculate()
+    {
+        const Int_t nRows = fEnergies.Steps + 1;
+        const size_t rowSize = size_t(fDistances.Steps + 1) * kNQuantities;
 
-        Int_t nComps = fTargetMaterial.Compounds.size();
-        fstream.write(reinterpret_cast<const char*>(&nComps), sizeof(nComps));
+        fFile.reset();
+        resize();
 
-        for (auto i = 0; i < nComps; ++i)
+        Int_t nWorkers = gNumberOfWorkers > 0 ? gNumberOfWorkers : std::thread::hardware_concurrency();
+        nWorkers = std::min(nWorkers, nRows);
+        if (nWorkers > 1 && !isSingleThreaded())
         {
-            fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.Compounds[i].Mass_u),
-                          sizeof(fTargetMaterial.Compounds[i].Mass_u));
-            fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.Compounds[i].Charge_e),
-                          sizeof(fTargetMaterial.Compounds[i].Charge_e));
-            fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.Compounds[i].Ratio),
-                          sizeof(fTargetMaterial.Compounds[i].Ratio));
+            LOG(WARNING) << "R3BAtima::Cache: Several threads are running, calculating the cache in this process only";
+            nWorkers = 1;
         }
 
-        fstream.write(reinterpret_cast<const char*>(&fEnergies.MinValue), sizeof(fEnergies.MinValue));
-        fstream.write(reinterpret_cast<const char*>(&fEnergies.MaxValue), sizeof(fEnergies.MaxValue));
-        fstream.write(reinterpret_cast<const char*>(&fEnergies.Steps), sizeof(fEnergies.Steps));
+        // ATIMA keeps its state in Fortran common blocks and is not reentrant,
+        // so the rows are calculated by forked processes instead of threads.
+        // They return their results through a shared anonymous mapping.
+        const size_t tableSize = fTable.size() * sizeof(Double_t);
+        void* shared = MAP_FAILED;
+        if (nWorkers > 1)
+            shared = mmap(NULL, tableSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
 
-        fstream.write(reinterpret_cast<const char*>(&fDistances.MinValue), sizeof(fDistances.MinValue));
-        fstream.write(reinterpret_cast<const char*>(&fDistances.MaxValue), sizeof(fDistances.MaxValue));
-        fstream.write(reinterpret_cast<const char*>(&fDistances.Steps), sizeof(fDistances.Steps));
-
-        fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.Density), sizeof(fTargetMaterial.Density));
-        fstream.write(reinterpret_cast<const char*>(&fTargetMaterial.IsGas), sizeof(fTargetMaterial.IsGas));
-
-        Int_t nPoints = 0;
-        for (int i = 0; i <= fEnergies.Steps; ++i)
+        if (shared == MAP_FAILED)
         {
-            for (int j = 0; j <= fDistances.Steps; ++j)
+            for (Int_t i = 0; i < nRows; ++i)
             {
-                fstream.write(reinterpret_cast<char*>(&fG_ELoss.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_EStrag.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_AngStrag.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_Range.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_RemainigRange.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_dEdXIn.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_dEdXOut.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_ToF.GetZ()[nPoints]), sizeof(Double_t));
-                fstream.write(reinterpret_cast<char*>(&fG_InterpolatedTargetThickness.GetZ()[nPoints]),
-                              sizeof(Double_t));
-
-                ++nPoints;
+                calculateRow(i, point(i, 0));
+                std::cout << "\rR3BAtima::Cache: Creating Cache: " << (i + 1) * (fDistances.Steps + 1) << "/"
+                          << nRows * (fDistances.Steps + 1) << std::flush;
             }
+            std::cout << std::endl;
+            return;
         }
 
-        fstream.write(reinterpret_cast<const char*>(&Version), sizeof(Version));
-    }
+        LOG(INFO) << "R3BAtima::Cache: Creating Cache of " << nRows * (fDistances.Steps + 1) << " points with "
+                  << nWorkers << " processes";
 
-    void Cache::calculate()
-    {
-        UInt_t currStep = 0;
-        const auto maxStep = (fEnergies.Steps + 1) * (fDistances.Steps + 1);
-
-        fG_ELoss.Clear();
-        fG_ELoss.Set(maxStep);
-        fG_EStrag.Clear();
-        fG_EStrag.Set(maxStep);
-        fG_AngStrag.Clear();
-        fG_AngStrag.Set(maxStep);
-        fG_Range.Clear();
-        fG_Range.Set(maxStep);
-        fG_RemainigRange.Clear();
-        fG_RemainigRange.Set(maxStep);
-        fG_dEdXIn.Clear();
-        fG_dEdXIn.Set(maxStep);
-        fG_dEdXOut.Clear();
-        fG_dEdXOut.Set(maxStep);
-        fG_ToF.Clear();
-        fG_ToF.Set(maxStep);
-        fG_InterpolatedTargetThickness.Clear();
-        fG_InterpolatedTargetThickness.Set(maxStep);
-
-        auto energy = fEnergies.MinValue;
-        for (int i = 0; i <= fEnergies.Steps; ++i)
+        Double_t* sharedTable = static_cast<Double_t*>(shared);
+        std::vector<pid_t> workers;
+        std::vector<bool> done(nRows, false);
+        for (Int_t w = 0; w < nWorkers; ++w)
         {
-            auto distance = fDistances.MinValue;
-            for (int j = 0; j <= fDistances.Steps; ++j)
+            const pid_t pid = fork();
+            if (pid == 0)
             {
-                auto res = Calculate_mm(fProjMass, fProjCharge, energy, fTargetMaterial, distance);
-
-                fG_ELoss.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.ELoss_MeV_per_u);
-                fG_EStrag.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.EStrag_MeV_per_u);
-                fG_AngStrag.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.AngStrag_mRad);
-                fG_Range.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.Range_mg_per_cm2);
-                fG_RemainigRange.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.RemainingRange_mg_per_cm2);
-                fG_dEdXIn.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.dEdXIn_MeVcm2_per_mg);
-                fG_dEdXOut.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.dEdXOut_MeVcm2_per_mg);
-                fG_ToF.SetPoint(currStep, res.EnergyIn_MeV_per_u, distance, res.ToF_ns);
-                fG_InterpolatedTargetThickness.SetPoint(
-                    currStep, res.EnergyIn_MeV_per_u, distance, res.InterpolatedTargetThickness);
-
-                distance += (fDistances.MaxValue - fDistances.MinValue) / fDistances.Steps;
-
-                std::cout << "\rR3BAtima::Cache: Creating Cache: " << ++currStep << "/" << maxStep << std::flush;
+                for (Int_t i = w; i < nRows; i += nWorkers)
+                    calculateRow(i, sharedTable + i * rowSize);
+                _exit(0);
             }
+            if (pid > 0)
+            {
+                workers.push_back(pid);
+                for (Int_t i = w; i < nRows; i += nWorkers)
+                    done[i] = true;
+            }
+        }
 
-            energy += (fEnergies.MaxValue - fEnergies.MinValue) / fEnergies.Steps;
+        Bool_t failed = kFALSE;
+        for (const auto pid : workers)
+        {
+            int status;
+            if (waitpid(pid, &status, 0) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+                failed = kTRUE;
         }
-        std::cout << std::endl;
+        if (failed)
+            LOG(FATAL) << "R3BAtima::Cache: A process creating the cache failed!";
+
+        // Rows of workers that could not be started
+        for (Int_t i = 0; i < nRows; ++i)
+            if (!done[i])
+                calculateRow(i, sharedTable + i * rowSize);
+
+        std::copy(sharedTable, sharedTable + fTable.size(), fTable.begin());
+        munmap(shared, tableSize);
     }
 } // namespace R3BAtima
@@ -14,16 +14,37 @@
 #ifndef R3BATIMACACHE_H
 #define R3BATIMACACHE_H
 
-#include "TGraph2D.h"
 #include "TString.h"
 
 #include "R3BAtima.h"
+#include "R3BAtimaCacheFile.h"
+
+#include <memory>
+#include <vector>
 
 namespace R3BAtima
 {
+    /**
+     * Transport results on a regular grid of energies and distances.
+     *
+     * All quantities of a grid point are stored next to each other, so a
+     * query finds its grid cell once and interpolates all of them from the
+     * same few table entries.
+     *
+     * The table can be calculated by several processes in parallel, see
+     * SetNumberOfWorkers. With a path given, it is taken from a binary
+     * CacheFile mapped into memory instead if that matches, so concurrent
+     * jobs on a node share one copy.
+     */
     class Cache
     {
       public:
+        enum class Interpolation
+        {
+            Bilinear, // between the 4 corners of the grid cell
+            Bicubic   // Catmull-Rom spline through the 4x4 surrounding grid points
+        };
+
         struct RangeSelector
         {
             // RangeSelector(const Double_t min, const Double_t max, const Int_t steps) : MinValue(min), MaxValue(max),
@@ -45,6 +66,7 @@ namespace R3BAtima
               const RangeSelector& energies_MeV_per_u,
               const TargetMaterial& targetMaterial,
               const RangeSelector& distances_mm);
+        // path: cache file, or a directory in which the file is named after GetKey()
         Cache(const Double_t pMass_u,
               const Double_t pCharge_e,
               const RangeSelector& energies_MeV_per_u,
@@ -54,26 +76,73 @@ namespace R3BAtima
 
         TransportResult operator()(const Double_t energy_MeV_per_u, const Double_t distance_mm) const;
 
+        // Results for n pairs of energies and distances
+        void operator()(const Int_t n,
+                        const Double_t* energies_MeV_per_u,
+                        const Double_t* distances_mm,
+                        TransportResult* results) const;
+
+        // Hash of projectile, material and ranges identifying the cache file
+        ULong64_t GetKey() const;
+
+        // Number of processes calculating a table, 1 by default, 0: one per core.
+        // Worker processes are only forked while the calling process runs a single thread.
+        static void SetNumberOfWorkers(const UInt_t nWorkers);
+
+        void SetInterpolation(const Interpolation interpolation) { fInterpolation = interpolation; }
+        Interpolation GetInterpolation() const { return fInterpolation; }
+
       private:
-        Bool_t read(const TString& path);
-        void write(const TString& path) const;
+        // Quantities stored per grid point, in the order of the cache file
+        enum Quantity
+        {
+            kELoss,
+            kEStrag,
+            kAngStrag,
+            kRange,
+            kRemainingRange,
+            kdEdXIn,
+            kdEdXOut,
+            kToF,
+            kInterpolatedTargetThickness,
+            kNQuantities
+        };
+
+        Bool_t read(const TString& fileName);
+        void write(const TString& fileName) const;
         void calculate();
 
+        // Cache file header and compounds describing this cache
+        CacheFile::Header header() const;
+        std::vector<Double_t> compounds() const;
+
+        // Calculates the grid points of one energy into row
+        void calculateRow(const Int_t iEnergy, Double_t* row) const;
+
+        // Allocates the table for the current ranges
+        void resize();
+        Double_t* point(const Int_t iEnergy, const Int_t iDistance)
+        {
+            return &fTable[(iEnergy * (fDistances.Steps + 1) + iDistance) * kNQuantities];
+        }
+
+        // Interpolates all quantities at (energy, distance) into res
+        void evaluate(const Double_t energy_MeV_per_u, const Double_t distance_mm, TransportResult& res) const;
+
         Double_t fProjMass;
         Double_t fProjCharge;
         RangeSelector fEnergies;
         TargetMaterial fTargetMaterial; //!
         RangeSelector fDistances;
 
-        mutable TGraph2D fG_ELoss;
-        mutable TGraph2D fG_EStrag;
-        mutable TGraph2D fG_AngStrag;
-        mutable TGraph2D fG_Range;
-        mutable TGraph2D fG_RemainigRange;
-        mutable TGraph2D fG_dEdXIn;
-        mutable TGraph2D fG_dEdXOut;
-        mutable TGraph2D fG_ToF;
-        mutable TGraph2D fG_InterpolatedTargetThickness;
+        Interpolation fInterpolation;
+
+        // kNQuantities values per grid point, with the distance running fastest.
+        // Empty if the table is taken from fFile.
+        std::vector<Double_t> fTable;
+        std::shared_ptr<CacheFile> fFile; //!
+
+        const Double_t* table() const { return fFile ? fFile->GetData() : fTable.data(); }
     };
 } // namespace R3BAtima
 #endif
@@ -0,0 +1,159 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BAtimaCacheFile.h"
+
+#include "FairLogger.h"
+
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <string>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(R3BAtima::CacheFile::Header) == 128, "R3BAtima::CacheFile: unexpected header size");
+
+namespace
+{
+    const char c_magic[8] = "R3BATIM";
+}
+
+namespace R3BAtima
+{
+    CacheFile::CacheFile()
+        : fMapping(NULL)
+        , fSize(0)
+        , fCompounds(NULL)
+        , fData(NULL)
+    {
+    }
+
+    CacheFile::~CacheFile() { Close(); }
+
+    Bool_t CacheFile::Open(const char* fileName)
+    {
+        Close();
+
+        const int fd = open(fileName, O_RDONLY);
+        if (fd < 0)
+            return kFALSE;
+
+        struct stat status;
+        if (fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(Header))
+        {
+            close(fd);
+            return kFALSE;
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        void* mapping = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+        close(fd);
+        if (mapping == MAP_FAILED)
+        {
+            LOG(ERROR) << "R3BAtima::CacheFile: Could not map file " << fileName;
+            return kFALSE;
+        }
+        fMapping = mapping;
+        fSize = status.st_size;
+
+        const Header& header = GetHeader();
+        if (memcmp(header.fMagic, c_magic, sizeof(c_magic)) != 0 || header.fVersion != kVersion)
+        {
+            Close();
+            return kFALSE;
+        }
+
+        const size_t nValues = size_t(header.fEnergySteps + 1) * size_t(header.fDistanceSteps + 1) *
+                               size_t(header.fNQuantities);
+        if (header.fNCompounds < 0 || header.fEnergySteps < 0 || header.fDistanceSteps < 0 ||
+            header.fHeaderSize != sizeof(Header) + 3 * header.fNCompounds * sizeof(Double_t) ||
+            fSize != header.fHeaderSize + nValues * sizeof(Double_t))
+        {
+            LOG(ERROR) << "R3BAtima::CacheFile: Size of " << fileName << " does not match its grid";
+            Close();
+            return kFALSE;
+        }
+
+        fCompounds = reinterpret_cast<const Double_t*>(static_cast<const char*>(fMapping) + sizeof(Header));
+        fData = reinterpret_cast<const Double_t*>(static_cast<const char*>(fMapping) + header.fHeaderSize);
+        return kTRUE;
+    }
+
+    void CacheFile::Close()
+    {
+        if (fMapping)
+            munmap(fMapping, fSize);
+        fMapping = NULL;
+        fSize = 0;
+        fCompounds = NULL;
+        fData = NULL;
+    }
+
+    Bool_t CacheFile::Write(const char* fileName, Header header, const Double_t* compounds, const Double_t* data)
+    {
+        memcpy(header.fMagic, c_magic, sizeof(c_magic));
+        header.fVersion = kVersion;
+        header.fHeaderSize = sizeof(Header) + 3 * header.fNCompounds * sizeof(Double_t);
+        memset(header.fReserved, 0, sizeof(header.fReserved));
+
+        const std::string tmpName = std::string(fileName) + "." + std::to_string(getpid()) + ".tmp";
+        std::ofstream fstream(tmpName.c_str(), std::ofstream::binary | std::ofstream::trunc);
+        if (!fstream.is_open())
+        {
+            LOG(ERROR) << "R3BAtima::CacheFile: Could not open file " << tmpName;
+            return kFALSE;
+        }
+
+        const size_t nValues = size_t(header.fEnergySteps + 1) * size_t(header.fDistanceSteps + 1) *
+                               size_t(header.fNQuantities);
+        fstream.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+        fstream.write(reinterpret_cast<const char*>(compounds), 3 * header.fNCompounds * sizeof(Double_t));
+        fstream.write(reinterpret_cast<const char*>(data), nValues * sizeof(Double_t));
+        fstream.close();
+        if (!fstream || rename(tmpName.c_str(), fileName) != 0)
+        {
+            LOG(ERROR) << "R3BAtima::CacheFile: I/O error writing " << fileName;
+            remove(tmpName.c_str());
+            return kFALSE;
+        }
+        return kTRUE;
+    }
+
+    Int_t CacheFile::Lock(const char* fileName)
+    {
+        const std::string lockName = std::string(fileName) + ".lock";
+        const int fd = open(lockName.c_str(), O_RDWR | O_CREAT, 0666);
+        if (fd < 0)
+            return -1;
+        if (flock(fd, LOCK_EX) != 0)
+        {
+            close(fd);
+            return -1;
+        }
+        return fd;
+    }
+
+    void CacheFile::Unlock(const char* fileName, const Int_t lock)
+    {
+        if (lock < 0)
+            return;
+        const std::string lockName = std::string(fileName) + ".lock";
+        unlink(lockName.c_str());
+        flock(lock, LOCK_UN);
+        close(lock);
+    }
+} // namespace R3BAtima
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BATIMACACHEFILE_H
+#define R3BATIMACACHEFILE_H
+
+#include "Rtypes.h"
+
+#include <cstddef>
+
+namespace R3BAtima
+{
+    /**
+     * Binary cache file, mapped read-only into memory.
+     *
+     * The file starts with a fixed-size header describing projectile, grid
+     * and material, followed by mass, charge and ratio of each material
+     * compound and then the table of the cache as native doubles, see
+     * Cache.
+     *
+     * Since the table is never copied, all processes reading the same file
+     * share its pages in the operating system's page cache.
+     */
+    class CacheFile
+    {
+      public:
+        // File header, 128 bytes
+        struct Header
+        {
+            char fMagic[8];                      // "R3BATIM"
+            UInt_t fVersion;                     // Format version
+            UInt_t fHeaderSize;                  // Offset of the table [bytes]
+            ULong64_t fKey;                      // Hash of the remaining fields and the compounds
+            Double_t fProjMass, fProjCharge;     // Projectile [u], [e]
+            Double_t fEnergyMin, fEnergyMax;     // Energy range [MeV/u]
+            Double_t fDistanceMin, fDistanceMax; // Distance range [mm]
+            Int_t fEnergySteps, fDistanceSteps;  // Number of grid steps
+            Double_t fDensity;                   // Material density [g/cm3]
+            Int_t fIsGas;                        // Material is a gas
+            Int_t fNCompounds;                   // Number of material compounds
+            Int_t fNQuantities;                  // Values per grid point
+            char fReserved[28];                  // Zero
+        };
+
+        // Current format version
+        static const UInt_t kVersion = 1;
+
+        CacheFile();
+
+        // Unmaps the file
+        ~CacheFile();
+
+        // Maps a file into memory and checks its header and size.
+        // Returns kFALSE if it does not exist or is no valid cache file.
+        Bool_t Open(const char* fileName);
+
+        void Close();
+
+        Bool_t IsOpen() const { return fMapping != NULL; }
+
+        const Header& GetHeader() const { return *static_cast<const Header*>(fMapping); }
+
+        // Mass, charge and ratio of each compound in turn
+        const Double_t* GetCompounds() const { return fCompounds; }
+
+        const Double_t* GetData() const { return fData; }
+
+        // Writes a cache file. Magic, version and header size are filled in.
+        // The file is written under a temporary name and renamed when
+        // complete, so readers never see a partial file.
+        static Bool_t Write(const char* fileName, Header header, const Double_t* compounds, const Double_t* data);
+
+        // Takes an exclusive lock on fileName + ".lock", waiting for other
+        // processes holding it. Returns the lock descriptor or -1.
+        static Int_t Lock(const char* fileName);
+        // Removes the lock file and releases the lock. Processes still
+        // waiting for it find the cache file once they get the lock.
+        static void Unlock(const char* fileName, const Int_t lock);
+
+      private:
+        CacheFile(const CacheFile&);
+        const CacheFile& operator=(const CacheFile&);
+
+        void* fMapping;             // Start of the mapped file
+        size_t fSize;               // Size of the mapped file [bytes]
+        const Double_t* fCompounds; // Start of the compounds
+        const Double_t* fData;      // Start of the table
+    };
+} // namespace R3BAtima
+
+#endif
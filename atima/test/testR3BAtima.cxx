@@ -15,6 +15,8 @@
 #include "R3BAtimaCache.h"
 #include "gtest/gtest.h"
 
+#include <cmath>
+
 namespace
 {
     constexpr auto ELOSS_Prot100 = 1.085;
@@ -34,6 +36,51 @@ namespace
         EXPECT_LT(cache(107., 10.).ELoss_MeV_per_u, ELOSS_Prot100);
     }
 
+    TEST(testR3BAtima, cacheGridPoints)
+    {
+        auto cache = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        const auto exact = R3BAtima::Calculate_mm(1., 1., 130., R3BAtima::TargetMaterial::LH2, 30.).ELoss_MeV_per_u;
+        EXPECT_NEAR(cache(130., 30.).ELoss_MeV_per_u, exact, 1e-9);
+        cache.SetInterpolation(R3BAtima::Cache::Interpolation::Bicubic);
+        EXPECT_NEAR(cache(130., 30.).ELoss_MeV_per_u, exact, 1e-9);
+    }
+
+    TEST(testR3BAtima, cacheInterpolation)
+    {
+        auto cache = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        const auto exact = R3BAtima::Calculate_mm(1., 1., 134., R3BAtima::TargetMaterial::LH2, 27.).ELoss_MeV_per_u;
+        const auto bilinear = cache(134., 27.).ELoss_MeV_per_u;
+        cache.SetInterpolation(R3BAtima::Cache::Interpolation::Bicubic);
+        const auto bicubic = cache(134., 27.).ELoss_MeV_per_u;
+        EXPECT_NEAR(bilinear, exact, 0.01 * exact);
+        EXPECT_LE(std::abs(bicubic - exact), std::abs(bilinear - exact));
+    }
+
+    TEST(testR3BAtima, cacheBatch)
+    {
+        const auto cache = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        const Double_t energies[3] = { 100., 153.7, 200. };
+        const Double_t distances[3] = { 50., 12.5, 10. };
+        R3BAtima::TransportResult results[3];
+        cache(3, energies, distances, results);
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_EQ(results[i].ELoss_MeV_per_u, cache(energies[i], distances[i]).ELoss_MeV_per_u);
+            EXPECT_EQ(results[i].ToF_ns, cache(energies[i], distances[i]).ToF_ns);
+        }
+    }
+
+    TEST(testR3BAtima, parallelCalculation)
+    {
+        R3BAtima::Cache::SetNumberOfWorkers(1);
+        const auto cache1 = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        R3BAtima::Cache::SetNumberOfWorkers(4);
+        const auto cache2 = R3BAtima::Cache(1., 1., { 100., 200., 10 }, R3BAtima::TargetMaterial::LH2, { 10., 50., 4 });
+        R3BAtima::Cache::SetNumberOfWorkers(1);
+        EXPECT_EQ(cache1(137., 23.).ELoss_MeV_per_u, cache2(137., 23.).ELoss_MeV_per_u);
+        EXPECT_EQ(cache1(200., 50.).ToF_ns, cache2(200., 50.).ToF_ns);
+    }
+
     TEST(testR3BAtima, writeReadCache)
     {
         {
@@ -29,13 +29,23 @@
 
 #include "R3BCalifaCrystalCalData.h"
 #include "R3BCalifaGeometry.h"
-#include <list>
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 #include "ROOT_template_hacks.h"
 using roothacks::TCAHelper;
 using roothacks::TypedCollection;
 
+namespace
+{
+    double circleAbs(double dphi)
+    {
+        double d = fmod(fabs(dphi), 2 * M_PI);
+        return d < M_PI ? d : 2 * M_PI - d;
+    }
+} // namespace
+
 R3BCalifaCrystalCal2Hit::R3BCalifaCrystalCal2Hit()
     : FairTask("R3B CALIFA CrystalCal to Hit Finder")
     , fCrystalHitCA(NULL)
@@ -123,6 +133,9 @@ InitStatus R3BCalifaCrystalCal2Hit::Init()
         fCalifatoTargetPos = fTargetPos - fCalifaPos;
     }
 
+    BuildCrystalPositions();
+    BuildNeighbours();
+
     return kSUCCESS;
 }
 
@@ -132,55 +145,125 @@ InitStatus R3BCalifaCrystalCal2Hit::ReInit()
     return kSUCCESS;
 }
 
+void R3BCalifaCrystalCal2Hit::BuildCrystalPositions()
+{
+    fCrystalPositions.assign(2433, CrystalPosition{ TVector3(NAN, NAN, NAN), NAN, NAN, NAN, kFALSE });
+    fNeighbours.clear();
+
+    const Int_t nbPositions = std::min(2432, fCalifaGeo->GetNumCrystals() / 2);
+    Int_t nbValid = 0;
+    for (Int_t id = 1; id <= nbPositions; ++id)
+    {
+        // Not all crystals are mounted in every setup, do not complain about them here
+        if (!gGeoManager || !gGeoManager->CheckPath(fCalifaGeo->GetCrystalVolumePath(id)))
+            continue;
+        auto& position = fCrystalPositions[id];
+        position.vector = GetAnglesVector(id);
+        position.theta = position.vector.Theta();
+        position.phi = position.vector.Phi();
+        position.rho = position.vector.Mag();
+        position.valid = !std::isnan(position.rho);
+        nbValid += position.valid;
+    }
+    LOG(INFO) << "R3BCalifaCrystalCal2Hit::BuildCrystalPositions() : " << nbValid << " crystal positions.";
+}
+
+void R3BCalifaCrystalCal2Hit::BuildNeighbours()
+{
+    fNeighbours.clear();
+    if (fClusterAlgorithmSelector != RECT && fClusterAlgorithmSelector != ROUND && fClusterAlgorithmSelector != CONE)
+        return;
+
+    // The windows are symmetric, so each pair is only tested once
+    fNeighbours.resize(fCrystalPositions.size());
+    for (size_t i = 1; i < fCrystalPositions.size(); ++i)
+    {
+        if (!fCrystalPositions[i].valid)
+            continue;
+        for (size_t j = i; j < fCrystalPositions.size(); ++j)
+            if (fCrystalPositions[j].valid && InWindow(fCrystalPositions[i], fCrystalPositions[j]))
+            {
+                fNeighbours[i].push_back(Int_t(j));
+                if (j != i)
+                    fNeighbours[j].push_back(Int_t(i));
+            }
+    }
+}
+
+Int_t R3BCalifaCrystalCal2Hit::PositionIndex(Int_t crystalId) const
+{
+    // same mapping of double reading channels as R3BCalifaGeometry::GetAngles
+    const Int_t nbCrystals = fCalifaGeo->GetNumCrystals();
+    if (crystalId > nbCrystals / 2 && crystalId <= nbCrystals)
+        crystalId -= nbCrystals / 2;
+    if (crystalId < 1 || crystalId >= Int_t(fCrystalPositions.size()) || !fCrystalPositions[crystalId].valid)
+        return 0;
+    return crystalId;
+}
+
+bool R3BCalifaCrystalCal2Hit::InWindow(const CrystalPosition& ref, const CrystalPosition& hit) const
+{
+    switch (fClusterAlgorithmSelector)
+    {
+        case RECT: // rectangular window
+            return TMath::Abs(ref.theta - hit.theta) < fDeltaPolar && circleAbs(ref.phi - hit.phi) < fDeltaAzimuthal;
+        case ROUND: // round window
+            // The angle is scaled to a reference distance (e.g. here is
+            // set to 35 cm) to take into account Califa's non-spherical
+            // geometry. The reference angle will then have to be defined
+            // in relation to this reference distance: for example, 10° at
+            // 35 cm corresponds to ~6cm, setting a fDeltaAngleClust=10
+            // means that the gamma rays will be allowed to travel 6 cm in
+            // the CsI, no matter the position of the crystal they hit.
+            return ref.vector.Angle(hit.vector) * ((ref.rho + hit.rho) / (35. * 2.)) < fDeltaAngleClust;
+        case CONE:
+            return ref.vector.Angle(hit.vector) < fDeltaAngleClust;
+        default:
+            return false;
+    }
+}
+
 bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCrystalCalData* hit)
 {
     if (ref == hit)
         return 1;
 
-    auto circleAbs = [](double dphi) {
-        double d = fmod(fabs(dphi), 2 * M_PI);
-        return d < M_PI ? d : 2 * M_PI - d;
-    };
     // Clusterization: you want to put a condition on the angle between the highest
     // energy crystal and the others. This is done by using the TVector3 classes and
     // not with different DeltaAngle on theta and phi, to get a proper solid angle
     // and not a "square" one.                    Enrico Fiori
+    bool takeCrystalInCluster = false;
+    if (fClusterAlgorithmSelector == RECT || fClusterAlgorithmSelector == ROUND || fClusterAlgorithmSelector == CONE)
+    {
+        if (fNeighbours.empty())
+            BuildNeighbours();
+
+        // The window only depends on the crystal positions, look it up
+        const Int_t refIndex = PositionIndex(ref->GetCrystalId());
+        const Int_t hitIndex = PositionIndex(hit->GetCrystalId());
+        if (refIndex && hitIndex)
+        {
+            const auto& neighbours = fNeighbours[refIndex];
+            takeCrystalInCluster = std::binary_search(neighbours.begin(), neighbours.end(), hitIndex);
+        }
+        LOG(DEBUG) << "returning R3BCalifaCrystalCal2Hit::Match(" << ref->GetCrystalId() << ", "
+                   << hit->GetCrystalId() << ")=" << takeCrystalInCluster << " with alg " << fClusterAlgorithmSelector;
+        return takeCrystalInCluster;
+    }
+
     TVector3 vref = this->GetAnglesVector(ref->GetCrystalId());
     TVector3 vhit = this->GetAnglesVector(hit->GetCrystalId());
-    bool takeCrystalInCluster = false;
 
     // Check if the angle between the two vectors is less than the reference angle.
     switch (fClusterAlgorithmSelector)
     {
-        case RECT:
-        { // rectangular window
-            if (TMath::Abs(vref.Theta() - vhit.Theta()) < fDeltaPolar &&
-                circleAbs(vref.Phi() - vhit.Phi()) < fDeltaAzimuthal)
-            {
-                takeCrystalInCluster = true;
-            }
-            break;
-        }
         case ALL:
             takeCrystalInCluster = true;
             break;
         case NONE:
             break;
-        case ROUND: // round window
-            // The angle is scaled to a reference distance (e.g. here is
-            // set to 35 cm) to take into account Califa's non-spherical
-            // geometry. The reference angle will then have to be defined
-            // in relation to this reference distance: for example, 10° at
-            // 35 cm corresponds to ~6cm, setting a fDeltaAngleClust=10
-            // means that the gamma rays will be allowed to travel 6 cm in
-            // the CsI, no matter the position of the crystal they hit.
-            if (((vref.Angle(vhit)) * ((vref.Mag() + vhit.Mag()) / (35. * 2.))) < fDeltaAngleClust)
-            {
-                takeCrystalInCluster = true;
-            }
-            break;
         case ROUND_SCALED: // round window scaled with energy
-            // The same as before but the angular window is scaled
+            // The same as ROUND but the angular window is scaled
             // according to the energy of the hit in the higher energy
             // crystal. It needs a parameter that should be calibrated.
             {
@@ -191,9 +274,6 @@ bool R3BCalifaCrystalCal2Hit::Match(R3BCalifaCrystalCalData* ref, R3BCalifaCryst
                 }
             }
             break;
-        case CONE:
-            takeCrystalInCluster = vref.Angle(vhit) < fDeltaAngleClust;
-            break;
         case PETAL:
             takeCrystalInCluster = AngleToPetalId(vref) == AngleToPetalId(vhit);
         case INVALID:
@@ -219,56 +299,80 @@ void R3BCalifaCrystalCal2Hit::Exec(Option_t* opt)
     LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): crystal hits at start: " << numCrystalHits
                << "  ********************************";
 
-    if (numCrystalHits)
+    if (!numCrystalHits)
+        return;
+
+    // Index the hits by crystal ID, a later hit replaces an earlier one with the same ID
+    for (auto& aCalData : TypedCollection<R3BCalifaCrystalCalData>::cast(fCrystalHitCA))
     {
-        auto aCalData = dynamic_cast<R3BCalifaCrystalCalData*>((*fCrystalHitCA)[0]);
-        // printf("id=%d\n", aCalData->GetCrystalId());
+        const Int_t crystalId = aCalData.GetCrystalId();
+        if (crystalId < 0)
+        {
+            LOG(WARNING) << "R3BCalifaCrystalCal2Hit::Exec(): ignoring hit with crystal ID " << crystalId;
+            continue;
+        }
+        if (crystalId >= Int_t(fHitByCrystal.size()))
+        {
+            fHitByCrystal.resize(crystalId + 1, nullptr);
+            fRankByCrystal.resize(crystalId + 1, -1);
+        }
+        if (!fHitByCrystal[crystalId])
+            fTouchedCrystals.push_back(crystalId);
+        fHitByCrystal[crystalId] = &aCalData;
     }
-    else
-        return;
+    std::sort(fTouchedCrystals.begin(), fTouchedCrystals.end());
 
-    std::list<R3BCalifaCrystalCalData*> unusedCrystalHits;
+    auto hitAt = [&](Int_t crystalId) {
+        return crystalId >= 0 && crystalId < Int_t(fHitByCrystal.size()) ? fHitByCrystal[crystalId] : nullptr;
+    };
     auto addHit = [&](R3BCalifaCrystalCalData* aCalData) {
         if (aCalData->GetEnergy() > fThreshold)
-            unusedCrystalHits.push_back(aCalData);
-        else
-            LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): rejected hit in " << aCalData->GetCrystalId()
-                       << " because of low energy (E=" << aCalData->GetEnergy() << "<=" << fThreshold << "=E_threshold";
+            fHits.push_back(aCalData);
     };
 
     // get rid if redundant (dual range) crystals
+    for (const auto crystalId : fTouchedCrystals) // lower id, gamma branch?
     {
-        std::map<uint32_t, R3BCalifaCrystalCalData*> crystalId2Pos;
-        for (auto& aCalData : TypedCollection<R3BCalifaCrystalCalData>::cast(fCrystalHitCA))
-            crystalId2Pos[aCalData.GetCrystalId()] = &aCalData;
-
-        LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec():  crystalId2Pos.size()=" << crystalId2Pos.size();
-
-        for (auto& k1 : crystalId2Pos) // k1: lower id, gamma branch?
-            if (crystalId2Pos.count(k1.first + fNbCrystalsGammaRange))
-            {
-                auto proton = *crystalId2Pos.find(k1.first + fNbCrystalsGammaRange);
-                // k2: higher id, proton branch
-                if (proton.second->GetEnergy() < fDRThreshold)
-                    addHit(k1.second); // gamma
-                else
-                    addHit(proton.second);
-            }
-            else if (!crystalId2Pos.count(k1.first - fNbCrystalsGammaRange))
-                // not a hit where two ranges were hit
-                addHit(k1.second);
+        if (auto proton = hitAt(crystalId + fNbCrystalsGammaRange))
+        {
+            // higher id, proton branch
+            if (proton->GetEnergy() < fDRThreshold)
+                addHit(fHitByCrystal[crystalId]); // gamma
+            else
+                addHit(proton);
+        }
+        else if (!hitAt(crystalId - fNbCrystalsGammaRange))
+            // not a hit where two ranges were hit
+            addHit(fHitByCrystal[crystalId]);
     }
-    LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): after uniquifying, we have " << unusedCrystalHits.size()
+    LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): after uniquifying and threshold, we have " << fHits.size()
                << " crystal hits.";
 
-    unusedCrystalHits.sort(
-        [](R3BCalifaCrystalCalData* lhs, R3BCalifaCrystalCalData* rhs) { return lhs->GetEnergy() > rhs->GetEnergy(); });
+    // Seeds are taken in order of energy, equal energies in order of crystal ID
+    std::stable_sort(fHits.begin(), fHits.end(), [](R3BCalifaCrystalCalData* lhs, R3BCalifaCrystalCalData* rhs) {
+        return lhs->GetEnergy() > rhs->GetEnergy();
+    });
+    const Int_t nbHits = fHits.size();
+    for (Int_t rank = 0; rank < nbHits; ++rank)
+        fRankByCrystal[fHits[rank]->GetCrystalId()] = rank;
+    fUsed.assign(nbHits, false);
+
+    const bool window =
+        fClusterAlgorithmSelector == RECT || fClusterAlgorithmSelector == ROUND || fClusterAlgorithmSelector == CONE;
+    if (window && fNeighbours.empty())
+        BuildNeighbours();
+    // crystal IDs of both ranges at a position, see PositionIndex
+    const Int_t nbCrystals = fCalifaGeo->GetNumCrystals();
+    auto rankAt = [&](Int_t crystalId) {
+        return crystalId < Int_t(fRankByCrystal.size()) ? fRankByCrystal[crystalId] : -1;
+    };
+
     uint32_t clusterId = 0;
-    while (!unusedCrystalHits.empty())
+    for (Int_t seed = 0; seed < nbHits; ++seed)
     {
-        auto highest = unusedCrystalHits.front();
-        LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): starting cluster at "
-                   << "crystal " << highest->GetCrystalId() << ", E=" << highest->GetEnergy();
+        if (fUsed[seed])
+            continue;
+        auto highest = fHits[seed];
 
         // Note: we do not remove highest, but process it like any others
         uint64_t time = highest->GetTime();
@@ -277,21 +381,42 @@ void R3BCalifaCrystalCal2Hit::Exec(Option_t* opt)
         auto clusterHit =
             TCAHelper<R3BCalifaHitData>::AddNew(*fCalifaHitCA, time, vhighest.Theta(), vhighest.Phi(), clusterId);
 
-        // loop through remaining crystals, remove matches from list.
-        auto i = unusedCrystalHits.begin();
-        while (i != unusedCrystalHits.end())
-            if (this->Match(highest, *i))
+        if (window)
+        {
+            // Only the crystals in the window around highest can match,
+            // they are added in order of energy like all others
+            fUsed[seed] = true;
+            *clusterHit += *highest;
+
+            fMembers.clear();
+            if (const Int_t index = PositionIndex(highest->GetCrystalId()))
+                for (const auto neighbour : fNeighbours[index])
+                    for (const auto crystalId : { neighbour, neighbour + nbCrystals / 2 })
+                    {
+                        const Int_t rank = rankAt(crystalId);
+                        if (rank >= 0 && !fUsed[rank])
+                            fMembers.push_back(rank);
+                    }
+            std::sort(fMembers.begin(), fMembers.end());
+            for (const auto rank : fMembers)
             {
-                LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): adding  "
-                           << "crystal " << (*i)->GetCrystalId() << ", E=" << (*i)->GetEnergy();
-
-                *clusterHit += **i;
-                i = unusedCrystalHits.erase(i);
+                fUsed[rank] = true;
+                *clusterHit += *fHits[rank];
             }
-            else
-                ++i;
+        }
+        else
+        {
+            // loop through remaining crystals, highest matches itself first
+            for (Int_t rank = seed; rank < nbHits; ++rank)
+                if (!fUsed[rank] && this->Match(highest, fHits[rank]))
+                {
+                    fUsed[rank] = true;
+                    *clusterHit += *fHits[rank];
+                }
+        }
         ++clusterId;
     }
+    LOG(DEBUG) << "R3BCalifaCrystalCal2Hit::Exec(): " << clusterId << " clusters.";
 }
 
 void R3BCalifaCrystalCal2Hit::Reset()
@@ -300,6 +425,14 @@ void R3BCalifaCrystalCal2Hit::Reset()
     LOG(DEBUG) << "Clearing CalifaHitData Structure";
     if (fCalifaHitCA)
         fCalifaHitCA->Clear();
+
+    for (const auto crystalId : fTouchedCrystals)
+    {
+        fHitByCrystal[crystalId] = nullptr;
+        fRankByCrystal[crystalId] = -1;
+    }
+    fTouchedCrystals.clear();
+    fHits.clear();
 }
 
 void R3BCalifaCrystalCal2Hit::SelectGeometryVersion(Int_t version)
@@ -321,7 +454,13 @@ void R3BCalifaCrystalCal2Hit::SetDRThreshold(Double_t DRthresholdEne)
     LOG(INFO) << "R3BCalifaCrystalCal2Hit::SetDRThreshold to " << fDRThreshold << " keV.";
 }
 
-TVector3 R3BCalifaCrystalCal2Hit::GetAnglesVector(int id) { return fCalifaGeo->GetAngles(id); }
+TVector3 R3BCalifaCrystalCal2Hit::GetAnglesVector(int id)
+{
+    const Int_t index = fCrystalPositions.empty() ? 0 : PositionIndex(id);
+    if (index)
+        return fCrystalPositions[index].vector;
+    return fCalifaGeo->GetAngles(id);
+}
 
 R3BCalifaHitData* R3BCalifaCrystalCal2Hit::AddHit(UInt_t Nbcrystals,
                                                   Double_t ene,
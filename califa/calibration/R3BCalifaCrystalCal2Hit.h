@@ -20,6 +20,8 @@
 
 #include <TVector3.h>
 
+#include <vector>
+
 class TClonesArray;
 class R3BTGeoPar;
 
@@ -59,6 +61,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
         fClusterAlgorithmSelector = RECT;
         fDeltaPolar = xDeltaPolar;
         fDeltaAzimuthal = xDeltaAzimuthal;
+        fNeighbours.clear();
     }
 
     /** Public method SetRoundWindowAlg
@@ -70,6 +73,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     {
         fClusterAlgorithmSelector = ROUND;
         fDeltaAngleClust = xDeltaAngleClust;
+        fNeighbours.clear();
     }
 
     /** Public method SetRoundEnergyScaledAlg
@@ -94,6 +98,7 @@ class R3BCalifaCrystalCal2Hit : public FairTask
     {
         fClusterAlgorithmSelector = CONE;
         fDeltaAngleClust = xDeltaAngleClust;
+        fNeighbours.clear();
     }
 
     /** Public method SetPetalAlg
@@ -160,6 +165,51 @@ class R3BCalifaCrystalCal2Hit : public FairTask
 
     /** Method GetAnglesVector (calls R3BCalifaGeometry::GetAngles(id)) **/
     TVector3 GetAnglesVector(int id);
+
+    /** Crystal position with the angles used by the cluster windows **/
+    struct CrystalPosition
+    {
+        TVector3 vector; // as returned by GetAnglesVector
+        Double_t theta;  // vector.Theta()
+        Double_t phi;    // vector.Phi()
+        Double_t rho;    // vector.Mag()
+        Bool_t valid;    // crystal exists in the geometry
+    };
+
+    /** Method BuildCrystalPositions
+     **
+     ** Fills fCrystalPositions from the geometry
+     **/
+    void BuildCrystalPositions();
+
+    /** Method BuildNeighbours
+     **
+     ** Fills fNeighbours for the RECT, ROUND and CONE windows
+     **/
+    void BuildNeighbours();
+
+    /** Method PositionIndex
+     **
+     ** Index into fCrystalPositions for a crystal ID of either range, 0 if the crystal is unknown
+     **/
+    Int_t PositionIndex(Int_t crystalId) const;
+
+    /** Method InWindow
+     **
+     ** Geometric cluster condition of the RECT, ROUND and CONE windows
+     **/
+    bool InWindow(const CrystalPosition& ref, const CrystalPosition& hit) const;
+
+    std::vector<CrystalPosition> fCrystalPositions; //! Indexed by crystal ID of the first range
+    std::vector<std::vector<Int_t>> fNeighbours;    //! Sorted indices of the positions in the window of each position
+
+    // Per event clustering buffers, indexed by crystal ID or by rank in fHits
+    std::vector<R3BCalifaCrystalCalData*> fHitByCrystal; //! Last hit of each crystal ID
+    std::vector<Int_t> fRankByCrystal;                   //! Index into fHits, -1 if none
+    std::vector<Int_t> fTouchedCrystals;                 //! Crystal IDs set in fHitByCrystal, sorted
+    std::vector<R3BCalifaCrystalCalData*> fHits;         //! Hits above threshold, in order of energy
+    std::vector<bool> fUsed;                             //! Whether a hit is part of a cluster
+    std::vector<Int_t> fMembers;                         //! Ranks of the hits added to the current cluster
     TVector3 fTargetPos;
     TVector3 fCalifaPos;
     TVector3 fCalifatoTargetPos;
@@ -120,40 +120,44 @@ R3BCalifaGeometry::~R3BCalifaGeometry()
 
 const TVector3& R3BCalifaGeometry::GetAngles(Int_t iD)
 {
-    static std::map<int, TVector3> cache;
     Double_t local[3] = { 0, 0, 0 };
     Double_t master[3];
     const static TVector3 invalid(NAN, NAN, NAN);
     const char* nameVolume;
-    if (cache.count(iD))
-        return cache[iD];
 
     // SOLUTION FOR DOUBLE READING CHANNELS
     if (iD > fNumCrystals / 2 && iD <= fNumCrystals)
         iD = iD - fNumCrystals / 2; // for double reading crystals (crystals from 1 to 2432)
 
-    if (iD >= 1 && iD <= 2432)
+    if (iD < 1 || iD > 2432)
     {
-        nameVolume = GetCrystalVolumePath(iD);
-
-        gGeoManager->CdTop();
+        LOG(ERROR) << "R3BCalifaGeometry: Invalid crystalId: " << iD;
+        return invalid;
+    }
 
-        if (gGeoManager->CheckPath(nameVolume))
-            gGeoManager->cd(nameVolume);
-        else
-        {
-            LOG(ERROR) << "R3BCalifaGeometry: Invalid crystal path: " << nameVolume;
-            return invalid;
-        }
-        gGeoManager->LocalToMaster(local, master);
+    if (fAngles.empty())
+    {
+        fAngles.resize(2433);
+        fAnglesKnown.resize(2433, false);
     }
+    if (fAnglesKnown[iD])
+        return fAngles[iD];
+
+    nameVolume = GetCrystalVolumePath(iD);
+
+    gGeoManager->CdTop();
+
+    if (gGeoManager->CheckPath(nameVolume))
+        gGeoManager->cd(nameVolume);
     else
     {
-        LOG(ERROR) << "R3BCalifaGeometry: Invalid crystalId: " << iD;
+        LOG(ERROR) << "R3BCalifaGeometry: Invalid crystal path: " << nameVolume;
         return invalid;
     }
+    gGeoManager->LocalToMaster(local, master);
 
-    return cache[iD] = master;
+    fAnglesKnown[iD] = true;
+    return fAngles[iD] = master;
 }
 
 void R3BCalifaGeometry::GetAngles(Int_t iD, Double_t* polar, Double_t* azimuthal, Double_t* rho)
@@ -291,9 +295,8 @@ double R3BCalifaGeometry::GetDistanceThroughCrystals(TVector3& startVertex,
 
 int R3BCalifaGeometry::GetCrystalId(const char* volumePath)
 { /*
-   * Yes, regex matching in the stepping action is probably slow.
-   * But if we cared about speed, we would not use string processing here
-   * in the first place.
+   * Regex matching is slow, R3BCalifa::ProcessHits only falls back to it
+   * for volumes missing from its lookup of MC volume IDs.
    * At least, this way we have well defined behaviour if something fails,
    * instead of possible out of bounds access consequences (nasal demons etc).
    * Also, it hopefully works with the 2019/s444 geo file too, now.
@@ -310,16 +313,25 @@ int R3BCalifaGeometry::GetCrystalId(const char* volumePath)
         return 0;
     }
 
-    Int_t crystalId;
     Int_t alvType = std::stoi(m[1].str());      // converting to int the alveolus type
     Int_t alveolusCopy = std::stoi(m[2].str()); // converting to int the alveolus copy
     Int_t cryType = std::stoi(m[3].str());      // converting to int the crystal type
 
+    Int_t crystalId = GetCrystalId(alvType, alveolusCopy, cryType);
+    if (crystalId == 0)
+        LOG(INFO) << "path=" << volumePath;
+
+    return crystalId;
+}
+
+int R3BCalifaGeometry::GetCrystalId(Int_t alvType, Int_t alveolusCopy, Int_t cryType)
+{
+    Int_t crystalId;
+
     if (cryType < 1 || cryType > 4 || alvType < 1 || alvType > 23)
     { // cryType runs from 1 to 4 while alvType runs from 1 to 23
         LOG(ERROR) << "R3BCalifaGeometry: Wrong crystal numbers (1)";
         LOG(INFO) << "---- cryType: " << cryType << "   alvType: " << alvType;
-        LOG(INFO) << "path=" << volumePath;
         return 0;
     }
 
@@ -16,8 +16,10 @@
 
 #include <TFile.h>
 #include <TObject.h>
+#include <TVector3.h>
+
+#include <vector>
 
-class TVector3;
 class TGeoNavigator;
 
 /**
@@ -39,6 +41,7 @@ class R3BCalifaGeometry : public TObject
 
     /**
      * Gets position in polar coordinates of crystal with given ID.
+     * Positions are looked up in the geometry once and kept in a table indexed by crystal ID.
      * On error, the x,y and z component of the TVector3 are set to NAN.
      * @param iD crystal ID (depending on geometry version)
      */
@@ -73,6 +76,16 @@ class R3BCalifaGeometry : public TObject
      */
     int GetCrystalId(const char* volumePath);
 
+    /**
+     * Gets crystal ID for the alveolus and crystal numbers found in a volume path.
+     *
+     * @param alvType Alveolus type (1 to 23), from the alveolus volume name
+     * @param alveolusCopy Copy number of the alveolus
+     * @param cryType Crystal type (1 to 4), from the crystal volume name
+     * @return Crystal ID, 0 on error
+     */
+    static int GetCrystalId(Int_t alvType, Int_t alveolusCopy, Int_t cryType);
+
     /**
      * Calculate the distance of a given straight track through the active detector volume (crystal(s)). Usefull for
      * iPhos.
@@ -113,12 +126,20 @@ class R3BCalifaGeometry : public TObject
      */
     static R3BCalifaGeometry* Instance(Int_t version);
 
+    /**
+     * @return Number of crystal IDs, including the second range of double reading crystals
+     */
+    Int_t GetNumCrystals() const { return fNumCrystals; }
+
   private:
     Int_t fGeometryVersion;
     Int_t fNumCrystals;
     Bool_t fIsSimulation;
     TFile* f;
 
+    std::vector<TVector3> fAngles;  //! Crystal positions, indexed by crystal ID of the first range
+    std::vector<bool> fAnglesKnown; //! Whether the entry in fAngles was looked up already
+
     static R3BCalifaGeometry* inst;
 
     ClassDef(R3BCalifaGeometry, 8);
@@ -26,6 +26,7 @@
 #include "TVirtualMC.h"
 #include "TVirtualMCStack.h"
 
+#include <cstdio>
 #include <iostream>
 #include <stdlib.h>
 
@@ -86,11 +87,65 @@ void R3BCalifa::Initialize()
     vol->SetVisibility(kFALSE);
 
     // fCalifaGeo = R3BCalifaGeometry::Instance(fGeometryVersion);
+
+    BuildCrystalLookup();
+}
+
+void R3BCalifa::BuildCrystalLookup()
+{
+    fCrystalTypes.clear();
+    fAlveolusTypes.clear();
+
+    // Volume names follow the paths of R3BCalifaGeometry::GetCrystalVolumePath:
+    // Alveolus_<alvType> contains ... Crystal_<alvType>_<cryType>
+    TIter next(gGeoManager->GetListOfVolumes());
+    while (TGeoVolume* volume = static_cast<TGeoVolume*>(next()))
+    {
+        const char* name = volume->GetName();
+        Int_t type = 0;
+        std::vector<Int_t>* types = nullptr;
+        char rest = 0;
+        if (sscanf(name, "Crystal_%*[^_]_%d%c", &type, &rest) == 1)
+            types = &fCrystalTypes;
+        else if (sscanf(name, "Alveolus_%d%c", &type, &rest) == 1)
+            types = &fAlveolusTypes;
+        if (!types || type <= 0)
+            continue;
+
+        const Int_t mcId = gMC->VolId(name);
+        if (mcId <= 0)
+            continue;
+        if (types->size() <= static_cast<size_t>(mcId))
+            types->resize(mcId + 1, 0);
+        (*types)[mcId] = type;
+    }
+
+    LOG(DEBUG) << "R3BCalifa: crystal lookup covers " << fCrystalTypes.size() << " crystal and "
+               << fAlveolusTypes.size() << " alveolus volume IDs";
+}
+
+Int_t R3BCalifa::GetCurrentCrystalId()
+{
+    Int_t copy;
+    const Int_t crystalVolId = gMC->CurrentVolID(copy);
+    if (crystalVolId > 0 && static_cast<size_t>(crystalVolId) < fCrystalTypes.size() &&
+        fCrystalTypes[crystalVolId] > 0)
+    {
+        // Crystal_ in WrapCry_ in InnerAlv_ in Alveolus_
+        Int_t alveolusCopy;
+        const Int_t alveolusVolId = gMC->CurrentVolOffID(3, alveolusCopy);
+        if (alveolusVolId > 0 && static_cast<size_t>(alveolusVolId) < fAlveolusTypes.size() &&
+            fAlveolusTypes[alveolusVolId] > 0)
+            return R3BCalifaGeometry::GetCrystalId(
+                fAlveolusTypes[alveolusVolId], alveolusCopy, fCrystalTypes[crystalVolId]);
+    }
+
+    return fCalifaGeo->GetCrystalId(gMC->CurrentVolPath());
 }
 
 Bool_t R3BCalifa::ProcessHits(FairVolume* vol)
 {
-    Int_t crystalId = fCalifaGeo->GetCrystalId(gMC->CurrentVolPath());
+    Int_t crystalId = GetCurrentCrystalId();
     if (!fCsIDensity) // fill it in the first crystal
         fCsIDensity = gGeoManager->GetCurrentVolume()->GetMaterial()->GetDensity();
 
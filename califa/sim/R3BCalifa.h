@@ -18,6 +18,7 @@
 #include "TF1.h"
 #include "TLorentzVector.h"
 #include <map>
+#include <vector>
 
 class TClonesArray;
 class R3BCalifaPoint;
@@ -140,6 +141,11 @@ class R3BCalifa : public R3BDetector
 
     R3BCalifaGeometry* fCalifaGeo;
 
+    /** Crystal type for each MC volume ID, 0 if the volume is not a crystal **/
+    std::vector<Int_t> fCrystalTypes; //!
+    /** Alveolus type for each MC volume ID, 0 if the volume is not an alveolus **/
+    std::vector<Int_t> fAlveolusTypes; //!
+
     /** Private method AddPoint
      **
      ** Adds a CalifaPoint to the HitCollection
@@ -162,6 +168,21 @@ class R3BCalifa : public R3BDetector
      **/
     void ResetParameters();
 
+    /** Private method BuildCrystalLookup
+     **
+     ** Fills fCrystalTypes and fAlveolusTypes from the volume names, once
+     ** the geometry is constructed
+     **/
+    void BuildCrystalLookup();
+
+    /** Private method GetCurrentCrystalId
+     **
+     ** Crystal ID of the current volume from its MC volume ID and the
+     ** copy number of its alveolus. Falls back to matching the volume path
+     ** if the volume hierarchy is not the expected one.
+     **/
+    Int_t GetCurrentCrystalId();
+
     TGeoRotation* createMatrix(Double_t phi, Double_t theta, Double_t psi);
 
     ClassDef(R3BCalifa, 7);
@@ -141,92 +141,65 @@ void R3BCalifaDigitizer::Exec(Option_t* option)
     if (!nHits)
         return;
 
-    R3BCalifaPoint** pointData = NULL;
-    pointData = new R3BCalifaPoint*[nHits];
-    for (Int_t i = 0; i < nHits; i++)
-        pointData[i] = (R3BCalifaPoint*)(fCalifaPointDataCA->At(i));
-
-    Int_t crystalId;
-    Double_t Nf;
-    Double_t Ns;
-    Double_t time;
-    Double_t energy;
-
+    // Sum up the points of each crystal, in order of their first point
     for (Int_t i = 0; i < nHits; i++)
     {
-        crystalId = pointData[i]->GetCrystalId();
-        Nf = pointData[i]->GetNf();
-        Ns = pointData[i]->GetNs();
-        time = pointData[i]->GetTime();
-        energy = pointData[i]->GetEnergyLoss();
-
-        Int_t nCrystalCals = fCalifaCryCalDataCA->GetEntriesFast();
-        Bool_t existHit = 0;
-        if (nCrystalCals == 0)
-            AddCrystalCal(crystalId, NUSmearing(energy), Nf, Ns, time, 0);
+        auto point = (R3BCalifaPoint*)(fCalifaPointDataCA->At(i));
+        Int_t crystalId = point->GetCrystalId();
+        Double_t Nf = point->GetNf();
+        Double_t Ns = point->GetNs();
+        Double_t time = point->GetTime();
+        Double_t energy = NUSmearing(point->GetEnergyLoss());
+
+        if (crystalId < 0)
+        {
+            LOG(ERROR) << "R3BCalifaDigitizer::Exec() Point with invalid crystal ID " << crystalId;
+            continue;
+        }
+        if (crystalId >= Int_t(fCrystalSums.size()))
+        {
+            fCrystalSums.resize(crystalId + 1);
+            fCrystalHit.resize(crystalId + 1, false);
+        }
+
+        CrystalSum& sum = fCrystalSums[crystalId];
+        if (!fCrystalHit[crystalId])
+        {
+            fCrystalHit[crystalId] = true;
+            fTouchedCrystals.push_back(crystalId);
+            sum.energy = energy;
+            sum.Nf = Nf;
+            sum.Ns = Ns;
+            sum.time = time;
+        }
         else
         {
-            for (Int_t j = 0; j < nCrystalCals; j++)
-            {
-                if (((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->GetCrystalId() == crystalId)
-                {
-                    ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->AddMoreEnergy(NUSmearing(energy));
-                    ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->AddMoreNf(Nf);
-                    ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->AddMoreNs(Ns);
-                    if (((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->GetTime() > time)
-                    {
-                        ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(j)))->SetTime(time);
-                    }
-                    existHit = 1; // to avoid the creation of a new CrystalHit
-
-                    break;
-                }
-            }
-            if (!existHit)
-                AddCrystalCal(crystalId, NUSmearing(energy), Nf, Ns, time, 0);
+            sum.energy += energy;
+            sum.Nf += Nf;
+            sum.Ns += Ns;
+            if (sum.time > time)
+                sum.time = time;
         }
-        existHit = 0;
     }
 
-    if (pointData)
-        delete[] pointData;
-
-    Int_t nCrystalCals = fCalifaCryCalDataCA->GetEntriesFast();
-    if (nCrystalCals == 0)
-        return;
-
-    Double_t temp = 0;
-    Int_t tempCryID, parThres;
     Bool_t inUse;
-    Int_t tempIndex;
-    Float_t parReso;
+    Int_t parThres;
 
-    for (Int_t i = 0; i < nCrystalCals; i++)
+    for (const auto crystalId : fTouchedCrystals)
     {
-
-        tempCryID = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetCrystalId();
+        CrystalSum& sum = fCrystalSums[crystalId];
 
         if (!fRealConfig)
         {
-
-            temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetEnergy();
-            if (temp < fThreshold)
-            {
-                fCalifaCryCalDataCA->RemoveAt(i);
-                fCalifaCryCalDataCA->Compress();
-                nCrystalCals--; // remove from CalData those below threshold
-                i--;
-                continue;
-            }
+            if (sum.energy < fThreshold)
+                continue; // no CalData for those below threshold
 
             if (fResolution > 0)
-                ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetEnergy(ExpResSmearing(temp));
+                sum.energy = ExpResSmearing(sum.energy);
             if (fComponentRes > 0)
             {
-                temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetNf();
-                ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetNf(CompSmearing(temp));
-                temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetNs();
-                ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetNs(CompSmearing(temp));
+                sum.Nf = CompSmearing(sum.Nf);
+                sum.Ns = CompSmearing(sum.Ns);
             }
         }
 
@@ -234,37 +207,23 @@ void R3BCalifaDigitizer::Exec(Option_t* option)
 
         else
         {
+            inUse = fSim_Par->GetInUse(crystalId - 1);
+            fResolution = fSim_Par->GetResolution(crystalId - 1);
+            parThres = fSim_Par->GetThreshold(crystalId - 1);
 
-            temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetEnergy();
-
-            inUse = fSim_Par->GetInUse(tempCryID - 1);
-            fResolution = fSim_Par->GetResolution(tempCryID - 1);
-            parThres = fSim_Par->GetThreshold(tempCryID - 1);
-
-            if (inUse && parThres < temp * 1000000)
-            { // Thresholds are in KeV!!
+            if (!(inUse && parThres < sum.energy * 1000000)) // Thresholds are in KeV!!
+                continue; // no CalData for those below threshold
 
-                ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetEnergy(ExpResSmearing(temp));
+            sum.energy = ExpResSmearing(sum.energy);
 
-                if (fComponentRes > 0)
-                {
-                    temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetNf();
-                    ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetNf(CompSmearing(temp));
-                    temp = ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->GetNs();
-                    ((R3BCalifaCrystalCalData*)(fCalifaCryCalDataCA->At(i)))->SetNs(CompSmearing(temp));
-                }
-            }
-
-            else
+            if (fComponentRes > 0)
             {
-
-                fCalifaCryCalDataCA->RemoveAt(i); // remove from CalData those below threshold
-                fCalifaCryCalDataCA->Compress();
-                nCrystalCals--;
-                i--;
-                continue;
+                sum.Nf = CompSmearing(sum.Nf);
+                sum.Ns = CompSmearing(sum.Ns);
             }
         }
+
+        AddCrystalCal(crystalId, sum.energy, sum.Nf, sum.Ns, sum.time, 0);
     }
 }
 
@@ -288,6 +247,10 @@ void R3BCalifaDigitizer::Reset()
     if (fCalifaCryCalDataCA)
         fCalifaCryCalDataCA->Clear();
 
+    for (const auto crystalId : fTouchedCrystals)
+        fCrystalHit[crystalId] = false;
+    fTouchedCrystals.clear();
+
     ResetParameters();
 }
 
@@ -22,6 +22,8 @@
 #include "TClonesArray.h"
 #include "string"
 
+#include <vector>
+
 class R3BCalifaDigitizer : public FairTask
 {
 
@@ -122,6 +124,19 @@ class R3BCalifaDigitizer : public FairTask
 
     R3BCalifaCrystalPars4Sim* fSim_Par; // Parameter Container for a Realistic Simulation
 
+    /** Sum of the points in one crystal **/
+    struct CrystalSum
+    {
+        Double_t energy;
+        Double_t Nf;
+        Double_t Ns;
+        ULong64_t time; // earliest point
+    };
+
+    std::vector<CrystalSum> fCrystalSums; //! Indexed by crystal ID, valid where fCrystalHit is set
+    std::vector<bool> fCrystalHit;        //! Whether the crystal has points in this event
+    std::vector<Int_t> fTouchedCrystals;  //! Crystal IDs with points, in order of their first point
+
     /** Private method NUSmearing
      **
      ** Smears the energy according to some non-uniformity distribution
@@ -31,7 +31,6 @@
 //#include "R3BFieldMapCreator.h"
 #include "R3BFieldMapData.h"
 #include "R3BFieldPar.h"
-#include "TArrayI.h"
 
 using std::cerr;
 using std::cout;
@@ -45,6 +44,19 @@ using TMath::Nint;
 
 // -------------   Default constructor  ----------------------------------
 R3BFieldMap::R3BFieldMap()
+    : fScale(1.)
+    , stepsInX(0)
+    , stepsInY(0)
+    , stepsInZ(0)
+    , initialX(0.)
+    , initialY(0.)
+    , initialZ(0.)
+    , gridStep(0.)
+    , Bxfield(NULL)
+    , Byfield(NULL)
+    , Bzfield(NULL)
+    , typeField(-1)
+    , fVerbose(kFALSE)
 {
     // do nothing ..
 }
@@ -53,6 +65,19 @@ R3BFieldMap::R3BFieldMap()
 // -------------   Standard constructor   ---------------------------------
 R3BFieldMap::R3BFieldMap(const char* mapName, const char* fileType)
     : FairField(mapName)
+    , fScale(1.)
+    , stepsInX(0)
+    , stepsInY(0)
+    , stepsInZ(0)
+    , initialX(0.)
+    , initialY(0.)
+    , initialZ(0.)
+    , gridStep(0.)
+    , Bxfield(NULL)
+    , Byfield(NULL)
+    , Bzfield(NULL)
+    , typeField(-1)
+    , fVerbose(kFALSE)
 {
     // empty ctor
 }
@@ -60,6 +85,19 @@ R3BFieldMap::R3BFieldMap(const char* mapName, const char* fileType)
 // ------------------------------------------------------------------------
 R3BFieldMap::R3BFieldMap(Int_t type, Bool_t verbosity)
     : FairField("R3Bmap")
+    , fScale(1.)
+    , stepsInX(0)
+    , stepsInY(0)
+    , stepsInZ(0)
+    , initialX(0.)
+    , initialY(0.)
+    , initialZ(0.)
+    , gridStep(0.)
+    , Bxfield(NULL)
+    , Byfield(NULL)
+    , Bzfield(NULL)
+    , typeField(-1)
+    , fVerbose(kFALSE)
 {
 
     // specific to R3B to be consistent  with the geometry of the Aladin Magnet
@@ -78,9 +116,8 @@ R3BFieldMap::R3BFieldMap(Int_t type, Bool_t verbosity)
 
     Double_t DistanceFromtargetToAladinCenter = DistanceToTarget + Correction;
     // Transformations inverse
-    gRot = new TRotation();
-    gRot->RotateY(-1. * Aladin_angle);
-    gTrans = new TVector3(0.0, 0.0, -1. * DistanceFromtargetToAladinCenter);
+    fRot.RotateY(-1. * Aladin_angle);
+    fTrans.SetXYZ(0.0, 0.0, -1. * DistanceFromtargetToAladinCenter);
 
     // Magnetic field map types definition
     typeField = type;
@@ -204,6 +241,11 @@ R3BFieldMap::R3BFieldMap(Int_t type, Bool_t verbosity)
 // ------------------------------------------------------------------------
 
 void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
+{
+    static_cast<const R3BFieldMap*>(this)->GetFieldValue(point, bField);
+}
+
+void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField) const
 {
     // Main function to get the field values
     // not optimized  for the moment
@@ -215,7 +257,7 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
     {
 
         // local
-        TArrayI* linesArray = new TArrayI(8);
+        Int_t linesArray[8];
 
         // local to global
         TVector3 localPoint(point[0], point[1], point[2]);
@@ -225,8 +267,8 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
         //      << endl;
 
         // localPoint.Transform(*gRot);
-        localPoint = localPoint + (*gTrans); // First translation
-        localPoint.Transform(*gRot);
+        localPoint = localPoint + fTrans; // First translation
+        localPoint.Transform(fRot);
 
         // test area
         if (localPoint.X() >= initialX && localPoint.Y() >= initialY && localPoint.Z() >= initialZ &&
@@ -245,7 +287,7 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
             if (!returnValue)
             {
                 TVector3 vertexReferenceInGrid;
-                Int_t linpos = linesArray->At(0);
+                Int_t linpos = linesArray[0];
                 if (GetPositionForLine(linpos, &vertexReferenceInGrid))
                 {
                     cout << "-E-R3BFieldMap Line out of bound " << endl;
@@ -256,29 +298,29 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
                     Double_t u = (localPoint.Y() - vertexReferenceInGrid.Y()) / (gridStep);
                     Double_t v = (localPoint.Z() - vertexReferenceInGrid.Z()) / (gridStep);
 
-                    Bfield[0] = (1 - t) * (1 - u) * (1 - v) * Bxfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Bxfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Bxfield[linesArray->At(2)] + t * u * v * Bxfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Bxfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Bxfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Bxfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Bxfield[linesArray->At(7)];
-
-                    Bfield[1] = (1 - t) * (1 - u) * (1 - v) * Byfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Byfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Byfield[linesArray->At(2)] + t * u * v * Byfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Byfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Byfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Byfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Byfield[linesArray->At(7)];
-
-                    Bfield[2] = (1 - t) * (1 - u) * (1 - v) * Bzfield[linesArray->At(0)] +
-                                t * (1 - u) * (1 - v) * Bzfield[linesArray->At(1)] +
-                                t * u * (1 - v) * Bzfield[linesArray->At(2)] + t * u * v * Bzfield[linesArray->At(3)] +
-                                (1 - t) * u * (1 - v) * Bzfield[linesArray->At(4)] +
-                                (1 - t) * u * v * Bzfield[linesArray->At(5)] +
-                                (1 - t) * (1 - u) * v * Bzfield[linesArray->At(6)] +
-                                t * (1 - u) * v * Bzfield[linesArray->At(7)];
+                    Bfield[0] = (1 - t) * (1 - u) * (1 - v) * Bxfield[linesArray[0]] +
+                                t * (1 - u) * (1 - v) * Bxfield[linesArray[1]] +
+                                t * u * (1 - v) * Bxfield[linesArray[2]] + t * u * v * Bxfield[linesArray[3]] +
+                                (1 - t) * u * (1 - v) * Bxfield[linesArray[4]] +
+                                (1 - t) * u * v * Bxfield[linesArray[5]] +
+                                (1 - t) * (1 - u) * v * Bxfield[linesArray[6]] +
+                                t * (1 - u) * v * Bxfield[linesArray[7]];
+
+                    Bfield[1] = (1 - t) * (1 - u) * (1 - v) * Byfield[linesArray[0]] +
+                                t * (1 - u) * (1 - v) * Byfield[linesArray[1]] +
+                                t * u * (1 - v) * Byfield[linesArray[2]] + t * u * v * Byfield[linesArray[3]] +
+                                (1 - t) * u * (1 - v) * Byfield[linesArray[4]] +
+                                (1 - t) * u * v * Byfield[linesArray[5]] +
+                                (1 - t) * (1 - u) * v * Byfield[linesArray[6]] +
+                                t * (1 - u) * v * Byfield[linesArray[7]];
+
+                    Bfield[2] = (1 - t) * (1 - u) * (1 - v) * Bzfield[linesArray[0]] +
+                                t * (1 - u) * (1 - v) * Bzfield[linesArray[1]] +
+                                t * u * (1 - v) * Bzfield[linesArray[2]] + t * u * v * Bzfield[linesArray[3]] +
+                                (1 - t) * u * (1 - v) * Bzfield[linesArray[4]] +
+                                (1 - t) * u * v * Bzfield[linesArray[5]] +
+                                (1 - t) * (1 - u) * v * Bzfield[linesArray[6]] +
+                                t * (1 - u) * v * Bzfield[linesArray[7]];
                 }
 
             } //! returnValue
@@ -288,9 +330,9 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
                 cout << "-I- R3BFieldMap Point "
                      << " is just in one grid point!" << endl;
 
-                Bfield[0] = Bxfield[linesArray->At(0)];
-                Bfield[1] = Byfield[linesArray->At(0)];
-                Bfield[2] = Bzfield[linesArray->At(0)];
+                Bfield[0] = Bxfield[linesArray[0]];
+                Bfield[1] = Byfield[linesArray[0]];
+                Bfield[2] = Bzfield[linesArray[0]];
             } // returnValue ==1
 
             else
@@ -314,14 +356,6 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
             Bfield[1] = 0;
             Bfield[2] = 0;
         }
-        // Reset heap memory
-
-        if (linesArray)
-        {
-            delete linesArray;
-            linesArray = NULL;
-        }
-
         // linesArray
         // localPoint;
     }
@@ -341,6 +375,19 @@ void R3BFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
 
 // ------------   Constructor from R3BFieldPar   --------------------------
 R3BFieldMap::R3BFieldMap(R3BFieldPar* fieldPar)
+    : fScale(1.)
+    , stepsInX(0)
+    , stepsInY(0)
+    , stepsInZ(0)
+    , initialX(0.)
+    , initialY(0.)
+    , initialZ(0.)
+    , gridStep(0.)
+    , Bxfield(NULL)
+    , Byfield(NULL)
+    , Bzfield(NULL)
+    , typeField(-1)
+    , fVerbose(kFALSE)
 {
 
     /*
@@ -374,7 +421,12 @@ R3BFieldMap::R3BFieldMap(R3BFieldPar* fieldPar)
 // ------------------------------------------------------------------------
 
 // ------------   Destructor   --------------------------------------------
-R3BFieldMap::~R3BFieldMap() {}
+R3BFieldMap::~R3BFieldMap()
+{
+    delete[] Bxfield;
+    delete[] Byfield;
+    delete[] Bzfield;
+}
 // ------------------------------------------------------------------------
 
 // -----------   Intialisation   ------------------------------------------
@@ -391,31 +443,26 @@ void R3BFieldMap::Init()
     */
 }
 
-Int_t R3BFieldMap::GetLinesArrayForPosition(TVector3* pos, TArrayI* lines)
+Int_t R3BFieldMap::GetLinesArrayForPosition(TVector3* pos, Int_t lines[8]) const
 {
     //
-    TVector3* posAux = new TVector3();
-    Int_t tmp = GetLineForPosition(pos);
-    lines->AddAt(tmp, 0);
-    Int_t tmpPos = lines->At(0);
-    GetPositionForLine(tmpPos, posAux);
-    if ((*posAux) == (*pos))
+    TVector3 posAux;
+    lines[0] = GetLineForPosition(pos);
+    GetPositionForLine(lines[0], &posAux);
+    if (posAux == (*pos))
     {
-        delete posAux;
         return 1;
     }
 
     // Faster method
-    lines->AddAt(lines->At(0) + stepsInY * stepsInZ, 1);
-    lines->AddAt(lines->At(1) + stepsInZ, 2);
-    lines->AddAt(lines->At(2) + 1, 3);
-    lines->AddAt(lines->At(0) + stepsInZ, 4);
-    lines->AddAt(lines->At(4) + 1, 5);
-    lines->AddAt(lines->At(0) + 1, 6);
-    lines->AddAt(lines->At(1) + 1, 7);
-
-    if (posAux)
-        delete posAux;
+    lines[1] = lines[0] + stepsInY * stepsInZ;
+    lines[2] = lines[1] + stepsInZ;
+    lines[3] = lines[2] + 1;
+    lines[4] = lines[0] + stepsInZ;
+    lines[5] = lines[4] + 1;
+    lines[6] = lines[0] + 1;
+    lines[7] = lines[1] + 1;
+
     return 0;
 }
 
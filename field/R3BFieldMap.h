@@ -30,7 +30,6 @@
 #include "TRotation.h"
 #include "TVector3.h"
 
-class TArrayI;
 class TArrayF;
 class R3BFieldPar;
 
@@ -67,6 +66,8 @@ class R3BFieldMap : public FairField
     virtual void Print(Option_t* option = "") const;
     /** Main GetField function */
     virtual void GetFieldValue(const Double_t point[3], Double_t* bField);
+    /** As above, safe to call from several threads at once */
+    void GetFieldValue(const Double_t point[3], Double_t* bField) const;
 
     void SetVerbose(Bool_t verbosity) { fVerbose = verbosity; }
 
@@ -84,7 +85,7 @@ class R3BFieldMap : public FairField
 
     Int_t GetLineForPosition(TVector3* pos) const;
     Int_t GetPositionForLine(Int_t line, TVector3* pos) const;
-    Int_t GetLinesArrayForPosition(TVector3* pos, TArrayI* lines);
+    Int_t GetLinesArrayForPosition(TVector3* pos, Int_t lines[8]) const;
 
     /** Map file name **/
     TString fFileName;
@@ -108,12 +109,12 @@ class R3BFieldMap : public FairField
                      // 1 for R3B map, 2 for other possib .
                      // 3 ALADIN inverted for back tracking
 
-    TRotation* gRot;  //!
-    TVector3* gTrans; //!
+    TRotation fRot;  //! global to local rotation
+    TVector3 fTrans; //! global to local translation
 
     Bool_t fVerbose;
 
-    ClassDef(R3BFieldMap, 1)
+    ClassDef(R3BFieldMap, 2)
 };
 
 #endif
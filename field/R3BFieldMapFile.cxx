@@ -0,0 +1,148 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+// Includes from C
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "R3BFieldMapFile.h"
+
+using std::cerr;
+using std::endl;
+using std::ofstream;
+
+static_assert(sizeof(R3BFieldMapFile::Header) == 128, "R3BFieldMapFile: unexpected header size");
+
+namespace
+{
+    const char c_magic[8] = "R3BFMAP";
+}
+
+// -------------   Default constructor  ----------------------------------
+R3BFieldMapFile::R3BFieldMapFile()
+    : fMapping(NULL)
+    , fSize(0)
+    , fData(NULL)
+{
+}
+// ------------------------------------------------------------------------
+
+// ------------   Destructor   --------------------------------------------
+R3BFieldMapFile::~R3BFieldMapFile() { Close(); }
+// ------------------------------------------------------------------------
+
+// -----------   Map a file into memory   ---------------------------------
+Bool_t R3BFieldMapFile::Open(const char* fileName)
+{
+    Close();
+
+    const int fd = open(fileName, O_RDONLY);
+    if (fd < 0)
+    {
+        cerr << "-E- R3BFieldMapFile::Open: Could not open file " << fileName << endl;
+        return kFALSE;
+    }
+
+    struct stat status;
+    if (fstat(fd, &status) != 0 || size_t(status.st_size) < sizeof(Header))
+    {
+        cerr << "-E- R3BFieldMapFile::Open: File " << fileName << " is too short" << endl;
+        close(fd);
+        return kFALSE;
+    }
+
+    // The mapping stays valid after the descriptor is closed
+    void* mapping = mmap(NULL, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (mapping == MAP_FAILED)
+    {
+        cerr << "-E- R3BFieldMapFile::Open: Could not map file " << fileName << endl;
+        return kFALSE;
+    }
+    fMapping = mapping;
+    fSize = status.st_size;
+
+    const Header& header = GetHeader();
+    if (memcmp(header.fMagic, c_magic, sizeof(c_magic)) != 0)
+    {
+        cerr << "-E- R3BFieldMapFile::Open: " << fileName << " is not a binary field map" << endl;
+        Close();
+        return kFALSE;
+    }
+    if (header.fVersion != kVersion)
+    {
+        cerr << "-E- R3BFieldMapFile::Open: " << fileName << " has format version " << header.fVersion
+             << ", expected " << kVersion << endl;
+        Close();
+        return kFALSE;
+    }
+
+    const size_t nValues = 3 * size_t(header.fNx) * size_t(header.fNy) * size_t(header.fNz);
+    if (header.fHeaderSize < sizeof(Header) || header.fHeaderSize % sizeof(Float_t) != 0 ||
+        fSize != header.fHeaderSize + nValues * sizeof(Float_t))
+    {
+        cerr << "-E- R3BFieldMapFile::Open: Size of " << fileName << " does not match its grid" << endl;
+        Close();
+        return kFALSE;
+    }
+
+    fData = reinterpret_cast<const Float_t*>(static_cast<const char*>(fMapping) + header.fHeaderSize);
+    return kTRUE;
+}
+// ------------------------------------------------------------------------
+
+// -----------   Unmap the file   -----------------------------------------
+void R3BFieldMapFile::Close()
+{
+    if (fMapping)
+    {
+        munmap(fMapping, fSize);
+    }
+    fMapping = NULL;
+    fSize = 0;
+    fData = NULL;
+}
+// ------------------------------------------------------------------------
+
+// -----------   Write a binary map file   --------------------------------
+Bool_t R3BFieldMapFile::Write(const char* fileName, Header header, const Float_t* data)
+{
+    memcpy(header.fMagic, c_magic, sizeof(c_magic));
+    header.fVersion = kVersion;
+    header.fHeaderSize = sizeof(Header);
+    memset(header.fReserved, 0, sizeof(header.fReserved));
+
+    ofstream mapFile(fileName, std::ios::binary);
+    if (!mapFile.is_open())
+    {
+        cerr << "-E- R3BFieldMapFile::Write: Could not open file " << fileName << endl;
+        return kFALSE;
+    }
+
+    const size_t nValues = 3 * size_t(header.fNx) * size_t(header.fNy) * size_t(header.fNz);
+    mapFile.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+    mapFile.write(reinterpret_cast<const char*>(data), nValues * sizeof(Float_t));
+    mapFile.close();
+    if (!mapFile)
+    {
+        cerr << "-E- R3BFieldMapFile::Write: I/O error writing " << fileName << endl;
+        return kFALSE;
+    }
+    return kTRUE;
+}
+// ------------------------------------------------------------------------
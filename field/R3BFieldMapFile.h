@@ -0,0 +1,95 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BFIELDMAPFILE_H
+#define R3BFIELDMAPFILE_H 1
+
+#include "Rtypes.h"
+
+#include <cstddef>
+
+/** R3BFieldMapFile
+ **
+ ** Binary field map file, mapped read-only into memory.
+ **
+ ** The file starts with a fixed-size header describing the grid, followed
+ ** by the field values as native floats, Bx,By,Bz of each grid point in
+ ** turn with grid point index ix * ny * nz + iy * nz + iz [kG].
+ ** The values are stored unscaled and already rotated into the global
+ ** frame by the angle given in the header.
+ **
+ ** Since the data is never copied, all processes reading the same file
+ ** share its pages in the operating system's page cache.
+ **/
+class R3BFieldMapFile
+{
+  public:
+    /** File header, 128 bytes **/
+    struct Header
+    {
+        char fMagic[8];                                    /**< "R3BFMAP" */
+        UInt_t fVersion;                                   /**< Format version */
+        UInt_t fHeaderSize;                                /**< Offset of the field values [bytes] */
+        Int_t fType;                                       /**< Map type (symmetry) */
+        Int_t fNx, fNy, fNz;                               /**< Number of grid points */
+        Double_t fXmin, fXmax, fYmin, fYmax, fZmin, fZmax; /**< Grid limits in local coordinates [cm] */
+        Double_t fYAngle;                                  /**< Rotation applied to the field values [deg] */
+        Long64_t fSourceSize;                              /**< Size of the ASCII map converted [bytes], 0 if none */
+        Long64_t fSourceTime;                              /**< Modification time of the ASCII map converted [s] */
+        char fReserved[24];                                /**< Zero */
+    };
+
+    /** Current format version **/
+    static const UInt_t kVersion = 2;
+
+    R3BFieldMapFile();
+
+    /** Destructor, unmaps the file **/
+    ~R3BFieldMapFile();
+
+    /** Map a file into memory and check its header
+     ** @param fileName  Name of binary map file
+     ** @value kTRUE on success, else kFALSE (with error message)
+     **/
+    Bool_t Open(const char* fileName);
+
+    /** Unmap the file **/
+    void Close();
+
+    /** Whether a file is mapped **/
+    Bool_t IsOpen() const { return fMapping != NULL; }
+
+    /** Accessor to the file header **/
+    const Header& GetHeader() const { return *static_cast<const Header*>(fMapping); }
+
+    /** Accessor to the field values **/
+    const Float_t* GetData() const { return fData; }
+
+    /** Write a binary map file
+     ** @param fileName  Name of binary map file
+     ** @param header    Grid description, magic, version and header size are filled in
+     ** @param data      3 * nx * ny * nz field values
+     ** @value kTRUE on success, else kFALSE
+     **/
+    static Bool_t Write(const char* fileName, Header header, const Float_t* data);
+
+  private:
+    R3BFieldMapFile(const R3BFieldMapFile&);
+    const R3BFieldMapFile& operator=(const R3BFieldMapFile&);
+
+    void* fMapping;       /**< Start of the mapped file */
+    size_t fSize;         /**< Size of the mapped file [bytes] */
+    const Float_t* fData; /**< Start of the field values */
+};
+
+#endif
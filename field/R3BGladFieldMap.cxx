@@ -12,15 +12,18 @@
  ******************************************************************************/
 
 // Includes from C
+#include <algorithm>
+#include <atomic>
 #include <fstream>
 #include <iomanip>
 #include <iostream>
 
 // Includes from ROOT
-#include "TArrayF.h"
 #include "TFile.h"
 #include "TMath.h"
+#include "TSystem.h"
 
+#include "R3BFieldMapFile.h"
 #include "R3BGladFieldMap.h"
 
 using std::cerr;
@@ -34,6 +37,21 @@ using std::setw;
 using std::showpoint;
 using TMath::Nint;
 
+namespace
+{
+    // Source of R3BGladFieldMap::fMapId
+    std::atomic<ULong64_t> gNextMapId(1);
+
+    // Field values at the corners of the last grid cell used by a thread
+    struct CellCache
+    {
+        ULong64_t mapId;
+        Int_t index;
+        Double_t corners[3][8];
+    };
+    thread_local CellCache tCellCache = { 0, 0, {} };
+} // namespace
+
 // -------------   Default constructor  ----------------------------------
 R3BGladFieldMap::R3BGladFieldMap()
 {
@@ -43,7 +61,14 @@ R3BGladFieldMap::R3BGladFieldMap()
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fField = NULL;
+    fFieldFactor = 1.;
+    fMapFile = NULL;
+    fMapId = 0;
+    fStrideX = fStrideY = fStrideZ = 0;
+    fYAngle = 0.;
+    fSinY = 0.;
+    fCosY = 1.;
     fPosX = fPosY = fPosZ = 0.;
     fName = "";
     fFileName = "";
@@ -61,12 +86,21 @@ R3BGladFieldMap::R3BGladFieldMap(const char* mapName, const char* fileType)
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fField = NULL;
+    fFieldFactor = 1.;
+    fMapFile = NULL;
+    fMapId = 0;
+    fStrideX = fStrideY = fStrideZ = 0;
+    fYAngle = 0.;
+    fSinY = 0.;
+    fCosY = 1.;
     fName = mapName;
     TString dir = getenv("VMCWORKDIR");
     fFileName = dir + "/field/magField/R3B/" + mapName;
     if (fileType[0] == 'R')
         fFileName += ".root";
+    else if (fileType[0] == 'B')
+        fFileName += ".bin";
     else
         fFileName += ".dat";
     fType = 1;
@@ -83,7 +117,14 @@ R3BGladFieldMap::R3BGladFieldMap(R3BFieldPar* fieldPar)
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    fBx = fBy = fBz = NULL;
+    fField = NULL;
+    fFieldFactor = 1.;
+    fMapFile = NULL;
+    fMapId = 0;
+    fStrideX = fStrideY = fStrideZ = 0;
+    fYAngle = 0.;
+    fSinY = 0.;
+    fCosY = 1.;
     if (!fieldPar)
     {
         cerr << "-W- R3BGladFieldConst::R3BGladFieldMap: empty parameter container!" << endl;
@@ -106,15 +147,7 @@ R3BGladFieldMap::R3BGladFieldMap(R3BFieldPar* fieldPar)
 }
 
 // ------------   Destructor   --------------------------------------------
-R3BGladFieldMap::~R3BGladFieldMap()
-{
-    if (fBx)
-        delete fBx;
-    if (fBy)
-        delete fBy;
-    if (fBz)
-        delete fBz;
-}
+R3BGladFieldMap::~R3BGladFieldMap() { delete fMapFile; }
 // ------------------------------------------------------------------------
 
 // -----------   Intialisation   ------------------------------------------
@@ -124,10 +157,21 @@ void R3BGladFieldMap::Init()
     fPosY = 0.0;
     fPosZ = 163.4;
     fYAngle = -14.;
-    gTrans = new TVector3(-fPosX, -fPosY, -fPosZ);
+    // Rotation from global to local coordinates, as TVector3::RotateY(-fYAngle)
+    fSinY = TMath::Sin(-fYAngle * TMath::DegToRad());
+    fCosY = TMath::Cos(-fYAngle * TMath::DegToRad());
+    // Prefer the binary version of an ASCII map, it is mapped instead of parsed.
+    // It is skipped if it is outdated, then the ASCII map is read.
+    TString binFileName = fFileName;
+    if (binFileName.EndsWith(".dat"))
+        binFileName.Replace(binFileName.Length() - 4, 4, ".bin");
     //  if      (fFileName.EndsWith(".root")) ReadRootFile(fFileName, fName);
+    if (binFileName.EndsWith(".bin") && !gSystem->AccessPathName(binFileName) && ReadBinaryFile(binFileName, fFileName))
+        return;
     if (fFileName.EndsWith(".dat"))
         ReadAsciiFile(fFileName);
+    else if (fFileName.EndsWith(".bin"))
+        LOG(fatal) << "Init: Could not map binary file";
     else
     {
         cerr << "-E- R3BGladFieldMap::Init: No proper file name defined! (" << fFileName << ")" << endl;
@@ -139,124 +183,153 @@ void R3BGladFieldMap::Init()
 // -----------   Get x component of the field   ---------------------------
 Double_t R3BGladFieldMap::GetBx(Double_t x, Double_t y, Double_t z)
 {
-
-    // cout << "-I- get Bx called " << endl;
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
-
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
-
-    Int_t ix = 0;
-    Int_t iy = 0;
-    Int_t iz = 0;
-    Double_t dx = 0.;
-    Double_t dy = 0.;
-    Double_t dz = 0.;
-
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
-    {
-
-        // Get Bx field values at grid cell corners
-        fHa[0][0][0] = fBx->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBx->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBx->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBx->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBx->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBx->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBx->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBx->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (X) interpolated " << val << endl;
-        return (val);
-    }
-
-    return 0.;
+    const Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[0];
 }
 // ------------------------------------------------------------------------
 
 // -----------   Get y component of the field   ---------------------------
 Double_t R3BGladFieldMap::GetBy(Double_t x, Double_t y, Double_t z)
 {
+    const Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[1];
+}
+// ------------------------------------------------------------------------
 
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
+// -----------   Get z component of the field   ---------------------------
+Double_t R3BGladFieldMap::GetBz(Double_t x, Double_t y, Double_t z)
+{
+    const Double_t point[3] = { x, y, z };
+    Double_t bField[3];
+    GetFieldValue(point, bField);
+    return bField[2];
+}
+// ------------------------------------------------------------------------
 
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
+// -----------   Get all components of the field   ------------------------
+void R3BGladFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField)
+{
+    static_cast<const R3BGladFieldMap*>(this)->GetFieldValue(point, bField);
+}
 
-    Int_t ix = 0;
-    Int_t iy = 0;
-    Int_t iz = 0;
+void R3BGladFieldMap::GetFieldValue(const Double_t point[3], Double_t* bField) const
+{
+    Int_t index = 0;
     Double_t dx = 0.;
     Double_t dy = 0.;
     Double_t dz = 0.;
 
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
+    if (!FindCell(point, index, dx, dy, dz))
     {
-
-        // Get By field values at grid cell corners
-        fHa[0][0][0] = fBy->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBy->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBy->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBy->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBy->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBy->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBy->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBy->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (Y) interpolated " << val << endl;
-        return (val);
+        bField[0] = bField[1] = bField[2] = 0.;
+        return;
     }
 
-    return 0.;
+    // Consecutive points of a track mostly fall into the same cell
+    CellCache& cache = tCellCache;
+    if (cache.mapId != fMapId || cache.index != index)
+    {
+        GetCorners(index, cache.corners);
+        cache.mapId = fMapId;
+        cache.index = index;
+    }
+    Interpolate(cache.corners, dx, dy, dz, bField);
 }
 // ------------------------------------------------------------------------
 
-// -----------   Get z component of the field   ---------------------------
-Double_t R3BGladFieldMap::GetBz(Double_t x, Double_t y, Double_t z)
+// -----------   Get all components of the field at many points   ---------
+void R3BGladFieldMap::GetFieldValues(Int_t n, const Double_t* points, Double_t* bFields) const
 {
+    // Points are processed in blocks: first the cell search, then the
+    // interpolation as a branch-free loop over the block, which the
+    // compiler can vectorise.
+    const Int_t blockSize = 64;
+    Int_t index[blockSize];
+    Double_t inside[blockSize];
+    Double_t dx[blockSize];
+    Double_t dy[blockSize];
+    Double_t dz[blockSize];
+
+    if (!fField)
+    {
+        std::fill(bFields, bFields + 3 * n, 0.);
+        return;
+    }
 
-    Int_t ix = 0;
-    Int_t iy = 0;
-    Int_t iz = 0;
-    Double_t dx = 0.;
-    Double_t dy = 0.;
-    Double_t dz = 0.;
-
-    // transform to local coordinates
-    // local to global
-    TVector3 localPoint(x, y, z);
+    const Float_t* data = fField;
+    for (Int_t first = 0; first < n; first += blockSize)
+    {
+        const Int_t nBlock = TMath::Min(blockSize, n - first);
+        for (Int_t i = 0; i < nBlock; i++)
+        {
+            inside[i] = FindCell(&points[3 * (first + i)], index[i], dx[i], dy[i], dz[i]) ? 1. : 0.;
+        }
 
-    localPoint = localPoint + (*gTrans);
-    localPoint.RotateY(-fYAngle * TMath::DegToRad());
+        for (Int_t c = 0; c < 3; c++)
+        {
+            Double_t* out = &bFields[3 * first + c];
+            for (Int_t i = 0; i < nBlock; i++)
+            {
+                const Float_t* h = &data[index[i] + c];
+                const Double_t ha000 = h[0];
+                const Double_t ha100 = h[fStrideX];
+                const Double_t ha010 = h[fStrideY];
+                const Double_t ha110 = h[fStrideX + fStrideY];
+                const Double_t ha001 = h[fStrideZ];
+                const Double_t ha101 = h[fStrideX + fStrideZ];
+                const Double_t ha011 = h[fStrideY + fStrideZ];
+                const Double_t ha111 = h[fStrideX + fStrideY + fStrideZ];
+                const Double_t hb00 = ha000 + (ha100 - ha000) * dx[i];
+                const Double_t hb10 = ha010 + (ha110 - ha010) * dx[i];
+                const Double_t hb01 = ha001 + (ha101 - ha001) * dx[i];
+                const Double_t hb11 = ha011 + (ha111 - ha011) * dx[i];
+                const Double_t hc0 = hb00 + (hb10 - hb00) * dy[i];
+                const Double_t hc1 = hb01 + (hb11 - hb01) * dy[i];
+                out[3 * i] = inside[i] * (hc0 + (hc1 - hc0) * dz[i]) * fFieldFactor;
+            }
+        }
+    }
+}
+// ------------------------------------------------------------------------
 
-    if (IsInside(localPoint.X(), localPoint.Y(), localPoint.Z(), ix, iy, iz, dx, dy, dz))
+// -----------   Find the grid cell of a global point   -------------------
+Bool_t R3BGladFieldMap::FindCell(const Double_t point[3],
+                                 Int_t& index,
+                                 Double_t& dx,
+                                 Double_t& dy,
+                                 Double_t& dz) const
+{
+    // Transform to local coordinates
+    const Double_t xg = point[0] - fPosX;
+    const Double_t yl = point[1] - fPosY;
+    const Double_t zg = point[2] - fPosZ;
+    const Double_t xl = fSinY * zg + fCosY * xg;
+    const Double_t zl = fCosY * zg - fSinY * xg;
+
+    // Check for being outside the map range
+    if (!(xl >= fXmin && xl < fXmax && yl >= fYmin && yl < fYmax && zl >= fZmin && zl < fZmax))
     {
-
-        // Get Bz field values at grid cell corners
-        fHa[0][0][0] = fBz->At(ix * fNy * fNz + iy * fNz + iz);
-        fHa[1][0][0] = fBz->At((ix + 1) * fNy * fNz + iy * fNz + iz);
-        fHa[0][1][0] = fBz->At(ix * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[1][1][0] = fBz->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + iz);
-        fHa[0][0][1] = fBz->At(ix * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[1][0][1] = fBz->At((ix + 1) * fNy * fNz + iy * fNz + (iz + 1));
-        fHa[0][1][1] = fBz->At(ix * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-        fHa[1][1][1] = fBz->At((ix + 1) * fNy * fNz + (iy + 1) * fNz + (iz + 1));
-
-        // Return interpolated field value
-        Double_t val = Interpolate(dx, dy, dz);
-        // cout << " (Z) interpolated " << val << endl;
-        return (val);
+        index = 0;
+        dx = dy = dz = 0.;
+        return kFALSE;
     }
 
-    return 0.;
+    // Determine grid cell
+    const Int_t ix = Int_t((xl - fXmin) / fXstep);
+    const Int_t iy = Int_t((yl - fYmin) / fYstep);
+    const Int_t iz = Int_t((zl - fZmin) / fZstep);
+    index = ix * fStrideX + iy * fStrideY + iz * fStrideZ;
+
+    // Relative distance from grid point (in units of cell size)
+    dx = (xl - fXmin) / fXstep - Double_t(ix);
+    dy = (yl - fYmin) / fYstep - Double_t(iy);
+    dz = (zl - fZmin) / fZstep - Double_t(iz);
+
+    return kTRUE;
 }
 // ------------------------------------------------------------------------
 
@@ -348,8 +421,9 @@ void R3BGladFieldMap::WriteAsciiFile(const char* fileName)
                     Double_t perc = TMath::Nint(100. * index / nTot);
                     cout << "\b\b\b\b\b\b" << setw(3) << perc << " % " << flush;
                 }
-                mapFile << fBx->At(index) / factor << " " << fBy->At(index) / factor << " " << fBz->At(index) / factor
-                        << endl;
+                mapFile << fField[3 * index] * fFieldFactor / factor << " "
+                        << fField[3 * index + 1] * fFieldFactor / factor << " "
+                        << fField[3 * index + 2] * fFieldFactor / factor << endl;
             } // z-Loop
         }     // y-Loop
     }         // x-Loop
@@ -358,6 +432,56 @@ void R3BGladFieldMap::WriteAsciiFile(const char* fileName)
 }
 // ------------------------------------------------------------------------
 
+// ----------   Write the map to a binary file   --------------------------
+void R3BGladFieldMap::WriteBinaryFile(const char* fileName)
+{
+    cout << "-I- R3BGladFieldMap: Writing field map to binary file " << fileName << endl;
+    if (!fField)
+    {
+        cerr << "-E- R3BGladFieldMap::WriteBinaryFile: No field map loaded! " << endl;
+        return;
+    }
+
+    R3BFieldMapFile::Header header;
+    header.fType = fType;
+    header.fNx = fNx;
+    header.fNy = fNy;
+    header.fNz = fNz;
+    header.fXmin = fXmin;
+    header.fXmax = fXmax;
+    header.fYmin = fYmin;
+    header.fYmax = fYmax;
+    header.fZmin = fZmin;
+    header.fZmax = fZmax;
+    header.fYAngle = fYAngle;
+
+    // Remember the ASCII map, so that the binary file is not used once it changed
+    Long_t id, flags, modTime;
+    Long64_t size;
+    if (fFileName.EndsWith(".dat") && gSystem->GetPathInfo(fFileName, &id, &size, &flags, &modTime) == 0)
+    {
+        header.fSourceSize = size;
+        header.fSourceTime = modTime;
+    }
+    else
+    {
+        header.fSourceSize = 0;
+        header.fSourceTime = 0;
+    }
+
+    // Take out the scaling, the binary file holds the field of scale 1
+    const Double_t factor = fFieldFactor / fScale;
+    std::vector<Float_t> data(fField, fField + 3 * fNx * fNy * fNz);
+    if (factor != 1.)
+    {
+        for (auto& value : data)
+            value *= factor;
+    }
+
+    R3BFieldMapFile::Write(fileName, header, data.data());
+}
+// ------------------------------------------------------------------------
+
 // -------   Write field map to a ROOT file   -----------------------------
 /*
 void R3BGladFieldMap::WriteRootFile(const char* fileName,
@@ -430,21 +554,13 @@ void R3BGladFieldMap::Reset()
     fXstep = fYstep = fZstep = 0.;
     fNx = fNy = fNz = 0;
     fScale = 1.;
-    if (fBx)
-    {
-        delete fBx;
-        fBx = NULL;
-    }
-    if (fBy)
-    {
-        delete fBy;
-        fBy = NULL;
-    }
-    if (fBz)
-    {
-        delete fBz;
-        fBz = NULL;
-    }
+    fField = NULL;
+    fFieldFactor = 1.;
+    fFieldData.clear();
+    delete fMapFile;
+    fMapFile = NULL;
+    fMapId = 0;
+    fStrideX = fStrideY = fStrideZ = 0;
 }
 // ------------------------------------------------------------------------
 
@@ -492,9 +608,15 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
     fNx += 1;
     fNy += 1;
     fNz += 1;
-    fBx = new TArrayF(fNx * fNy * fNz);
-    fBy = new TArrayF(fNx * fNy * fNz);
-    fBz = new TArrayF(fNx * fNy * fNz);
+    fFieldData.assign(3 * fNx * fNy * fNz, 0.);
+    fField = fFieldData.data();
+    fFieldFactor = 1.;
+    delete fMapFile;
+    fMapFile = NULL;
+    fMapId = gNextMapId++;
+    fStrideZ = 3;
+    fStrideY = 3 * fNz;
+    fStrideX = 3 * fNy * fNz;
 
     // Read the field values
     Double_t factor = fScale * 10.; // Factor 10 for T -> kG
@@ -533,9 +655,9 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
                 TVector3 B(bx, by, bz);
                 B.RotateY(fYAngle * TMath::DegToRad());
 
-                fBx->AddAt(factor * B.X(), index1);
-                fBy->AddAt(factor * B.Y(), index1);
-                fBz->AddAt(factor * B.Z(), index1);
+                fFieldData[3 * index1] = factor * B.X();
+                fFieldData[3 * index1 + 1] = factor * B.Y();
+                fFieldData[3 * index1 + 2] = factor * B.Z();
                 // ------------------------------------------------------------------------------------------
 
                 //  cout << "-I- " << bx << " : " << by << " : "  << bz  << " : " << endl;
@@ -558,6 +680,74 @@ void R3BGladFieldMap::ReadAsciiFile(const char* fileName)
 }
 // ------------------------------------------------------------------------
 
+// -----   Map field map from binary file (private)   ---------------------
+Bool_t R3BGladFieldMap::ReadBinaryFile(const char* fileName, const char* sourceName)
+{
+    cout << "-I- R3BGladFieldMap: Mapping field map from binary file " << fileName << endl;
+    R3BFieldMapFile* mapFile = new R3BFieldMapFile();
+    if (!mapFile->Open(fileName))
+    {
+        delete mapFile;
+        return kFALSE;
+    }
+
+    const R3BFieldMapFile::Header& header = mapFile->GetHeader();
+    if (fType != header.fType)
+    {
+        cout << "-E- R3BGladFieldMap::ReadBinaryFile: Incompatible map types!" << endl;
+        cout << "    Field map is of type " << fType << " but map on file is of type " << header.fType << endl;
+        delete mapFile;
+        return kFALSE;
+    }
+    if (fYAngle != header.fYAngle)
+    {
+        cout << "-E- R3BGladFieldMap::ReadBinaryFile: Field on file is rotated by " << header.fYAngle
+             << " deg instead of " << fYAngle << " deg" << endl;
+        delete mapFile;
+        return kFALSE;
+    }
+
+    // A binary file converted from another version of the ASCII map is outdated
+    Long_t id, flags, modTime;
+    Long64_t size;
+    if (TString(sourceName).EndsWith(".dat") && gSystem->GetPathInfo(sourceName, &id, &size, &flags, &modTime) == 0 &&
+        (size != header.fSourceSize || modTime != header.fSourceTime))
+    {
+        cout << "-W- R3BGladFieldMap::ReadBinaryFile: " << fileName << " was not converted from the current "
+             << sourceName << endl;
+        delete mapFile;
+        return kFALSE;
+    }
+
+    fXmin = header.fXmin;
+    fXmax = header.fXmax;
+    fYmin = header.fYmin;
+    fYmax = header.fYmax;
+    fZmin = header.fZmin;
+    fZmax = header.fZmax;
+    fNx = header.fNx;
+    fNy = header.fNy;
+    fNz = header.fNz;
+    fXstep = (fXmax - fXmin) / Double_t(fNx - 1);
+    fYstep = (fYmax - fYmin) / Double_t(fNy - 1);
+    fZstep = (fZmax - fZmin) / Double_t(fNz - 1);
+    fStrideZ = 3;
+    fStrideY = 3 * fNz;
+    fStrideX = 3 * fNy * fNz;
+
+    // The values on file are unscaled, the scale is applied on evaluation
+    fFieldData.clear();
+    delete fMapFile;
+    fMapFile = mapFile;
+    fField = fMapFile->GetData();
+    fFieldFactor = fScale;
+    fMapId = gNextMapId++;
+
+    cout << "-I- R3BGladFieldMap: " << fNx * fNy * fNz << " entries mapped" << endl;
+    return kTRUE;
+}
+// ------------------------------------------------------------------------
+
 // -------------   Read field map from ROOT file (private)  ---------------
 /*
 void R3BGladFieldMap::ReadRootFile(const char* fileName,
@@ -653,22 +843,49 @@ void R3BGladFieldMap::SetField(const R3BGladFieldMapData* data) {
 }
 */
 
+// ------------   Field values at the cell corners (private)  ------------
+void R3BGladFieldMap::GetCorners(Int_t index, Double_t corners[3][8]) const
+{
+    const Float_t* h = &fField[index];
+    for (Int_t c = 0; c < 3; c++, h++)
+    {
+        corners[c][0] = h[0];
+        corners[c][1] = h[fStrideX];
+        corners[c][2] = h[fStrideY];
+        corners[c][3] = h[fStrideX + fStrideY];
+        corners[c][4] = h[fStrideZ];
+        corners[c][5] = h[fStrideX + fStrideZ];
+        corners[c][6] = h[fStrideY + fStrideZ];
+        corners[c][7] = h[fStrideX + fStrideY + fStrideZ];
+    }
+}
+// ------------------------------------------------------------------------
+
 // ------------   Interpolation in a grid cell (private)  -----------------
-Double_t R3BGladFieldMap::Interpolate(Double_t dx, Double_t dy, Double_t dz)
+void R3BGladFieldMap::Interpolate(const Double_t corners[3][8],
+                                  Double_t dx,
+                                  Double_t dy,
+                                  Double_t dz,
+                                  Double_t* bField) const
 {
+    for (Int_t c = 0; c < 3; c++)
+    {
+        // Field at grid cell corners
+        const Double_t* ha = corners[c];
 
-    // Interpolate in x coordinate
-    fHb[0][0] = fHa[0][0][0] + (fHa[1][0][0] - fHa[0][0][0]) * dx;
-    fHb[1][0] = fHa[0][1][0] + (fHa[1][1][0] - fHa[0][1][0]) * dx;
-    fHb[0][1] = fHa[0][0][1] + (fHa[1][0][1] - fHa[0][0][1]) * dx;
-    fHb[1][1] = fHa[0][1][1] + (fHa[1][1][1] - fHa[0][1][1]) * dx;
+        // Interpolate in x coordinate
+        const Double_t hb00 = ha[0] + (ha[1] - ha[0]) * dx;
+        const Double_t hb10 = ha[2] + (ha[3] - ha[2]) * dx;
+        const Double_t hb01 = ha[4] + (ha[5] - ha[4]) * dx;
+        const Double_t hb11 = ha[6] + (ha[7] - ha[6]) * dx;
 
-    // Interpolate in y coordinate
-    fHc[0] = fHb[0][0] + (fHb[1][0] - fHb[0][0]) * dy;
-    fHc[1] = fHb[0][1] + (fHb[1][1] - fHb[0][1]) * dy;
+        // Interpolate in y coordinate
+        const Double_t hc0 = hb00 + (hb10 - hb00) * dy;
+        const Double_t hc1 = hb01 + (hb11 - hb01) * dy;
 
-    // Interpolate in z coordinate
-    return fHc[0] + (fHc[1] - fHc[0]) * dz;
+        // Interpolate in z coordinate
+        bField[c] = (hc0 + (hc1 - hc0) * dz) * fFieldFactor;
+    }
 }
 // ------------------------------------------------------------------------
 
@@ -19,7 +19,9 @@
 #include "TRotation.h"
 #include "TVector3.h"
 
-class TArrayF;
+#include <vector>
+
+class R3BFieldMapFile;
 
 class R3BGladFieldMap : public FairField
 {
@@ -30,7 +32,7 @@ class R3BGladFieldMap : public FairField
 
     /** Standard constructor
      ** @param name       Name of field map
-     ** @param fileType   R = ROOT file, A = ASCII
+     ** @param fileType   R = ROOT file, A = ASCII, B = binary
      **/
     R3BGladFieldMap(const char* mapName, const char* fileType = "A");
 
@@ -43,7 +45,10 @@ class R3BGladFieldMap : public FairField
     /** Destructor **/
     virtual ~R3BGladFieldMap();
 
-    /** Initialisation (read map from file) **/
+    /** Initialisation (read map from file)
+     ** An ASCII map is taken from the binary file of the same name
+     ** with extension .bin instead, if that exists.
+     **/
     virtual void Init();
 
     /** Get the field components at a certain point
@@ -54,6 +59,24 @@ class R3BGladFieldMap : public FairField
     virtual Double_t GetBy(Double_t x, Double_t y, Double_t z);
     virtual Double_t GetBz(Double_t x, Double_t y, Double_t z);
 
+    /** Get all field components at a certain point in one pass
+     ** @param point     Point coordinates (global) [cm]
+     ** @param bField    (return) Field components [kG]
+     **/
+    virtual void GetFieldValue(const Double_t point[3], Double_t* bField);
+
+    /** As above, but safe to call from several threads at once. The field
+     ** values at the corners of the last grid cell are cached per thread.
+     **/
+    void GetFieldValue(const Double_t point[3], Double_t* bField) const;
+
+    /** Get all field components at many points
+     ** @param n         Number of points
+     ** @param points    Point coordinates (global) [cm], x,y,z of each point in turn
+     ** @param bFields   (return) Field components [kG], Bx,By,Bz of each point in turn
+     **/
+    void GetFieldValues(Int_t n, const Double_t* points, Double_t* bFields) const;
+
     /** Determine whether a point is inside the field map
      ** @param x,y,z              Point coordinates (global) [cm]
      ** @param ix,iy,iz (return)  Grid cell
@@ -73,6 +96,9 @@ class R3BGladFieldMap : public FairField
     /** Write the field map to an ASCII file **/
     void WriteAsciiFile(const char* fileName);
 
+    /** Write the field map to a binary file, see R3BFieldMapFile **/
+    void WriteBinaryFile(const char* fileName);
+
     /** Write field map data to a ROOT file **/
     // void WriteRootFile(const char* fileName, const char* mapName);
 
@@ -107,10 +133,13 @@ class R3BGladFieldMap : public FairField
     /** Accessor to global scaling factor  **/
     Double_t GetScale() const { return fScale; }
 
-    /** Accessors to the field value arrays **/
-    TArrayF* GetBx() const { return fBx; }
-    TArrayF* GetBy() const { return fBy; }
-    TArrayF* GetBz() const { return fBz; }
+    /** Accessor to the field values, Bx,By,Bz of each grid point in turn
+     ** with grid point index ix * fNy * fNz + iy * fNz + iz.
+     ** Multiplied by GetFieldFactor() they give the field [kG]. **/
+    const Float_t* GetFieldData() const { return fField; }
+
+    /** Accessor to the factor applied to GetFieldData() **/
+    Double_t GetFieldFactor() const { return fFieldFactor; }
 
     /** Accessor to field map file **/
     const char* GetFileName() { return fFileName.Data(); }
@@ -118,6 +147,10 @@ class R3BGladFieldMap : public FairField
     /** Screen output **/
     virtual void Print(Option_t* option = "") const;
 
+  private:
+    R3BGladFieldMap(const R3BGladFieldMap&);
+    const R3BGladFieldMap& operator=(const R3BGladFieldMap&);
+
   protected:
     /** Reset the field parameters and data **/
     void Reset();
@@ -125,16 +158,39 @@ class R3BGladFieldMap : public FairField
     /** Read the field map from an ASCII file **/
     void ReadAsciiFile(const char* fileName);
 
+    /** Map the field map from a binary file
+     ** @param fileName    Name of binary map file
+     ** @param sourceName  ASCII map the binary file has to be converted from, if it exists
+     ** @value kTRUE on success, kFALSE if the file is missing, invalid or outdated
+     **/
+    Bool_t ReadBinaryFile(const char* fileName, const char* sourceName);
+
     /** Read field map from a ROOT file **/
     // void ReadRootFile(const char* fileName, const char* mapName);
 
     /** Set field parameters and data **/
     // void SetField(const R3BGladFieldMapData* data);
 
-    /** Get field values by interpolation of the grid.
+    /** Transform a point from global to local coordinates and find its grid cell
+     ** @param point     Point coordinates (global) [cm]
+     ** @param index     (return) Offset of the lower cell corner in fField
+     ** @param dx,dy,dz  (return) Relative distance from grid point [cell units]
+     ** @value kTRUE if inside map, else kFALSE
+     **/
+    Bool_t FindCell(const Double_t point[3], Int_t& index, Double_t& dx, Double_t& dy, Double_t& dz) const;
+
+    /** Get the field values at the corners of a grid cell
+     ** @param index     Offset of the lower cell corner in fField
+     ** @param corners   (return) Field components at corner ix + 2 * iy + 4 * iz of the cell
+     **/
+    void GetCorners(Int_t index, Double_t corners[3][8]) const;
+
+    /** Get all field components by interpolation in a grid cell.
+     ** @param corners   Field components at the cell corners, see GetCorners
      ** @param dx,dy,dz  Relative distance from grid point [cell units]
+     ** @param bField    (return) Field components [kG]
      **/
-    Double_t Interpolate(Double_t dx, Double_t dy, Double_t dz);
+    void Interpolate(const Double_t corners[3][8], Double_t dx, Double_t dy, Double_t dz, Double_t* bField) const;
 
     /** Map file name **/
     TString fFileName;
@@ -156,23 +212,29 @@ class R3BGladFieldMap : public FairField
     /** Number of grid points  **/
     Int_t fNx, fNy, fNz; //
 
-    /** Arrays with the field values  **/
-    TArrayF* fBx; //!
-    TArrayF* fBy; //!
-    TArrayF* fBz; //!
+    /** Field values, Bx,By,Bz of each grid point in turn.
+     ** Points to fFieldData or into the mapped binary file. **/
+    const Float_t* fField; //!
 
-    /** Variables for temporary storage
-     ** Used in the very frequently called method GetFieldValue  **/
-    Double_t fHa[2][2][2]; //! Field at corners of a grid cell
-    Double_t fHb[2][2];    //! Interpolated field (2-dim)
-    Double_t fHc[2];       //! Interpolated field (1-dim)
+    /** Factor applied to the values in fField **/
+    Double_t fFieldFactor; //!
 
-    /** local transformation
-     **/
-    TRotation* gRot;  //!
-    TVector3* gTrans; //!
+    /** Field values read from an ASCII file **/
+    std::vector<Float_t> fFieldData; //!
+
+    /** Mapped binary file **/
+    R3BFieldMapFile* fMapFile; //!
+
+    /** Identifier of the loaded field values, unique within the process **/
+    ULong64_t fMapId; //!
+
+    /** Offsets in fField between neighbouring grid points **/
+    Int_t fStrideX, fStrideY, fStrideZ; //!
+
+    /** Precomputed global to local rotation **/
+    Double_t fSinY, fCosY; //!
 
-    ClassDef(R3BGladFieldMap, 2)
+    ClassDef(R3BGladFieldMap, 3)
 };
 
 #endif
@@ -198,7 +198,7 @@ void R3BNeulandCal2Hit::Exec(Option_t*)
         pos[2] = (plane + 0.5) * Neuland::BarSize_Z + fDistanceToTarget; // ig + fDistancesToFirstPlane[plane];
         pixel[2] = plane;
 
-        fHits.Insert({ barID, tdc[0], tdc[1], time, unsatEnergy[0], unsatEnergy[1], energy, pos, pixel });
+        fHits.Emplace(barID, tdc[0], tdc[1], time, unsatEnergy[0], unsatEnergy[1], energy, pos, pixel);
     }
 }
 
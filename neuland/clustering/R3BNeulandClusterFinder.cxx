@@ -14,6 +14,7 @@
 #include "R3BNeulandClusterFinder.h"
 #include "FairLogger.h"
 #include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <vector>
 
@@ -27,11 +28,20 @@ R3BNeulandClusterFinder::R3BNeulandClusterFinder(const Double_t dx,
     , fDigis(input)
     , fClusters(output)
 {
-    fClusteringEngine.SetClusteringCondition([=](const R3BNeulandHit& a, const R3BNeulandHit& b) {
-        return std::abs(a.GetPosition().X() - b.GetPosition().X()) < dx &&
-               std::abs(a.GetPosition().Y() - b.GetPosition().Y()) < dy &&
-               std::abs(a.GetPosition().Z() - b.GetPosition().Z()) < dz && std::abs(a.GetT() - b.GetT()) < dt;
-    });
+    fClusteringEngine.SetClusteringCondition(ClusteringCondition{ dx, dy, dz, dt });
+
+    // Hits can only be clustered if they are in the same or in neighboring cells of this grid
+    if (dx > 0 && dy > 0 && dz > 0 && dt > 0)
+    {
+        fClusteringEngine.SetCellFunction([=](const R3BNeulandHit& hit) {
+            return Neuland::ClusteringEngine<R3BNeulandHit, ClusteringCondition>::Cell{
+                { std::lround(std::floor(hit.GetPosition().X() / dx)),
+                  std::lround(std::floor(hit.GetPosition().Y() / dy)),
+                  std::lround(std::floor(hit.GetPosition().Z() / dz)),
+                  std::lround(std::floor(hit.GetT() / dt)) }
+            };
+        });
+    }
 }
 
 InitStatus R3BNeulandClusterFinder::Init()
@@ -56,7 +66,7 @@ void R3BNeulandClusterFinder::Exec(Option_t*)
 
     for (auto& cluster : clusteredDigis)
     {
-        fClusters.Insert(R3BNeulandCluster{ std::move(cluster) });
+        fClusters.Emplace(std::move(cluster));
     }
 }
 
@@ -29,6 +29,7 @@
 #include "R3BNeulandCluster.h"
 #include "R3BNeulandHit.h"
 #include "TCAConnector.h"
+#include <cmath>
 
 class R3BNeulandClusterFinder : public FairTask
 {
@@ -55,7 +56,19 @@ class R3BNeulandClusterFinder : public FairTask
     void Exec(Option_t*) override;
 
   private:
-    Neuland::ClusteringEngine<R3BNeulandHit> fClusteringEngine;
+    // Clustering condition as a functor type, such that the clustering engine can inline it
+    struct ClusteringCondition
+    {
+        Double_t dx, dy, dz, dt;
+        bool operator()(const R3BNeulandHit& a, const R3BNeulandHit& b) const
+        {
+            return std::abs(a.GetPosition().X() - b.GetPosition().X()) < dx &&
+                   std::abs(a.GetPosition().Y() - b.GetPosition().Y()) < dy &&
+                   std::abs(a.GetPosition().Z() - b.GetPosition().Z()) < dz && std::abs(a.GetT() - b.GetT()) < dt;
+        }
+    };
+
+    Neuland::ClusteringEngine<R3BNeulandHit, ClusteringCondition> fClusteringEngine;
     TCAInputConnector<R3BNeulandHit> fDigis;
     TCAOutputConnector<R3BNeulandCluster> fClusters;
 
@@ -14,6 +14,8 @@
 #include "DigitizingEngine.h"
 #include <algorithm>
 #include <cmath>
+#include <stdexcept>
+#include <string>
 
 namespace Neuland
 {
@@ -39,6 +41,12 @@ namespace Neuland
             fRightChannel->AddHit(time, light, dist);
         }
 
+        void Paddle::Reset()
+        {
+            fLeftChannel->Reset();
+            fRightChannel->Reset();
+        }
+
         bool Paddle::HasFired() const { return (fLeftChannel->HasFired() && fRightChannel->HasFired()); }
 
         bool Paddle::HasHalfFired() const
@@ -65,18 +73,50 @@ namespace Neuland
                                         const Double_t light,
                                         const Double_t dist)
     {
-        if (paddles.find(paddle_id) == paddles.end())
+        if (paddle_id < 0)
+        {
+            throw std::out_of_range("DigitizingEngine::DepositLight: Negative paddle id " + std::to_string(paddle_id));
+        }
+        if (extracted)
+        {
+            Clear();
+        }
+
+        if (static_cast<size_t>(paddle_id) >= paddles.size())
+        {
+            paddles.resize(paddle_id + 1);
+        }
+        auto& paddle = paddles[paddle_id];
+        if (!paddle)
         {
-            paddles[paddle_id] =
-                std::unique_ptr<Digitizing::Paddle>(new Digitizing::Paddle(this->BuildChannel(), this->BuildChannel()));
+            paddle = std::unique_ptr<Digitizing::Paddle>(
+                new Digitizing::Paddle(this->BuildChannel(), this->BuildChannel()));
         }
-        paddles.at(paddle_id)->DepositLight(time, light, dist);
+
+        // Keep the list of hit paddles ordered by id. Only done for the first deposit in each paddle.
+        const auto it = std::lower_bound(hitPaddles.begin(),
+                                         hitPaddles.end(),
+                                         paddle_id,
+                                         [](const std::pair<Int_t, const Digitizing::Paddle*>& kv, const Int_t id) {
+                                             return kv.first < id;
+                                         });
+        if (it == hitPaddles.end() || it->first != paddle_id)
+        {
+            hitPaddles.insert(it, std::make_pair(paddle_id, paddle.get()));
+        }
+
+        paddle->DepositLight(time, light, dist);
     }
 
     Double_t DigitizingEngine::GetTriggerTime() const
     {
         Double_t triggerTime = 1e100;
-        for (const auto& kv : paddles)
+        if (extracted)
+        {
+            // No light deposited since the last event
+            return triggerTime;
+        }
+        for (const auto& kv : hitPaddles)
         {
             const auto& paddle = kv.second;
 
@@ -93,9 +133,25 @@ namespace Neuland
         return triggerTime;
     }
 
-    std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> DigitizingEngine::ExtractPaddles()
+    const DigitizingEngine::PaddleView& DigitizingEngine::ExtractPaddles()
     {
-        return std::move(paddles);
+        if (extracted)
+        {
+            // No light deposited since the last event, do not return its paddles again
+            Clear();
+        }
+        extracted = true;
+        return hitPaddles;
+    }
+
+    void DigitizingEngine::Clear()
+    {
+        for (const auto& kv : hitPaddles)
+        {
+            paddles[kv.first]->Reset();
+        }
+        hitPaddles.clear();
+        extracted = false;
     }
 
 } // namespace Neuland
@@ -15,8 +15,8 @@
 #define NEULAND_DIGITIZING_ENGINE_H
 
 #include "Rtypes.h"
-#include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace Neuland
@@ -44,6 +44,9 @@ namespace Neuland
             virtual Double_t GetTDC() const = 0;
             virtual Double_t GetEnergy() const = 0;
 
+            // Remove all hits, such that the channel can be reused for the next event
+            virtual void Reset() { fPMTHits.clear(); }
+
           protected:
             std::vector<PMTHit> fPMTHits;
         };
@@ -53,6 +56,7 @@ namespace Neuland
           public:
             Paddle(std::unique_ptr<Channel> l, std::unique_ptr<Channel> r);
             void DepositLight(Double_t time, Double_t light, Double_t dist);
+            void Reset();
 
             bool HasFired() const;
             bool HasHalfFired() const;
@@ -82,12 +86,24 @@ namespace Neuland
         virtual ~DigitizingEngine() = default; // FIXME: Root doesn't like pure virtual destructors (= 0;)
         virtual std::unique_ptr<Digitizing::Channel> BuildChannel() = 0;
 
+        // Paddles with light deposited in the current event, ordered by paddle id
+        using PaddleView = std::vector<std::pair<Int_t, const Digitizing::Paddle*>>;
+
         void DepositLight(Int_t paddle_id, Double_t time, Double_t light, Double_t dist);
         Double_t GetTriggerTime() const;
-        std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> ExtractPaddles();
+
+        // Ends the event. The returned view stays valid until the next call of DepositLight, which starts a new event.
+        // Without DepositLight in between, the next call ends an empty event.
+        const PaddleView& ExtractPaddles();
+
+        // Discards all light deposited in the current event
+        void Clear();
 
       protected:
-        std::map<Int_t, std::unique_ptr<Digitizing::Paddle>> paddles;
+        // Paddles are created once on first use, indexed by paddle id, and reused in later events
+        std::vector<std::unique_ptr<Digitizing::Paddle>> paddles;
+        PaddleView hitPaddles;
+        bool extracted = false;
     };
 } // namespace Neuland
 
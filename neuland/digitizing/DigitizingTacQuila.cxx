@@ -39,13 +39,22 @@ namespace Neuland
 
         void Channel::AddHit(const Double_t mcTime, const Double_t mcLight, const Double_t dist)
         {
-            fPMTHits.emplace_back(mcTime, mcLight, dist);
-            // NOTE: Sorting after every hit may not be efficient, but this way
-            // FindThresholdExeeding hit can be made const
-            std::sort(fPMTHits.begin(), fPMTHits.end());
+            // NOTE: Hits are kept sorted by time, such that FindThresholdExceedingHit can be const.
+            // Light from one shower mostly arrives in time order, so the new hit usually goes to the back.
+            const Digitizing::PMTHit hit(mcTime, mcLight, dist);
+            fPMTHits.insert(std::upper_bound(fPMTHits.begin(), fPMTHits.end(), hit), hit);
             cachedFirstHitOverThresh.invalidate();
         }
 
+        void Channel::Reset()
+        {
+            Digitizing::Channel::Reset();
+            cachedFirstHitOverThresh.invalidate();
+            cachedQDC.invalidate();
+            cachedTDC.invalidate();
+            cachedEnergy.invalidate();
+        }
+
         bool Channel::HasFired() const
         {
             if (!cachedFirstHitOverThresh.valid())
@@ -25,6 +25,7 @@
 #include "TMath.h"
 #include "TString.h"
 #include <iostream>
+#include <map>
 #include <stdexcept>
 
 R3BNeulandDigitizer::R3BNeulandDigitizer(TString input, TString output)
@@ -84,44 +85,53 @@ InitStatus R3BNeulandDigitizer::Init()
 void R3BNeulandDigitizer::Exec(Option_t*)
 {
     fHits.Reset();
+    fDigitizingEngine->Clear();
 
     std::map<UInt_t, Double_t> paddleEnergyDeposit;
     // Look at each Land Point, if it deposited energy in the scintillator, store it with reference to the bar
-    for (const auto& point : fPoints.Retrieve())
+    fDepositingPoints.clear();
+    fPaddleIDs.clear();
+    fPositions.clear();
+    for (const auto& point : fPoints.View())
     {
-        if (point->GetEnergyLoss() > 0.)
+        if (point.GetEnergyLoss() > 0.)
         {
-            const Int_t paddleID = point->GetPaddle();
-
-            // Convert position of point to paddle-coordinates, including any rotation or translation
-            const TVector3 position = point->GetPosition();
-            const TVector3 converted_position = fNeulandGeoPar->ConvertToLocalCoordinates(position, paddleID);
-            LOG(DEBUG) << "NeulandDigitizer: Point in paddle " << paddleID
-                       << " with global position XYZ: " << position.X() << " " << position.Y() << " " << position.Z();
-            LOG(DEBUG) << "NeulandDigitizer: Converted to local position XYZ: " << converted_position.X() << " "
-                       << converted_position.Y() << " " << converted_position.Z();
-
-            // Within the paddle frame, the relevant distance of the light from the pmt is always given by the
-            // X-Coordinate
-            const Double_t dist = converted_position.X();
-            fDigitizingEngine->DepositLight(paddleID, point->GetTime(), point->GetLightYield() * 1000., dist);
-            paddleEnergyDeposit[paddleID] += point->GetEnergyLoss() * 1000;
-        } // eloss
-    }     // points
+            fDepositingPoints.push_back(&point);
+            fPaddleIDs.push_back(point.GetPaddle());
+            fPositions.push_back(point.GetPosition());
+        }
+    }
+
+    // Convert positions of all points to paddle-coordinates, including any rotation or translation
+    // Within the paddle frame, the relevant distance of the light from the pmt is always given by the X-Coordinate
+    fNeulandGeoPar->ConvertToLocalX(fPaddleIDs, fPositions, fDists);
+
+    for (size_t i = 0; i < fDepositingPoints.size(); i++)
+    {
+        const auto point = fDepositingPoints[i];
+        const Int_t paddleID = fPaddleIDs[i];
+        const Double_t dist = fDists[i];
+        LOG(DEBUG) << "NeulandDigitizer: Point in paddle " << paddleID << " with global position XYZ: "
+                   << fPositions[i].X() << " " << fPositions[i].Y() << " " << fPositions[i].Z();
+        LOG(DEBUG) << "NeulandDigitizer: Converted to local position X: " << dist;
+
+        fDigitizingEngine->DepositLight(paddleID, point->GetTime(), point->GetLightYield() * 1000., dist);
+        paddleEnergyDeposit[paddleID] += point->GetEnergyLoss() * 1000;
+    } // points
 
     const Double_t triggerTime = fDigitizingEngine->GetTriggerTime();
-    const auto paddles = fDigitizingEngine->ExtractPaddles();
+    const auto& paddles = fDigitizingEngine->ExtractPaddles();
 
     // Fill control histograms
     hMultOne->Fill(std::count_if(paddles.begin(),
                                  paddles.end(),
-                                 [](const std::pair<const Int_t, std::unique_ptr<Neuland::Digitizing::Paddle>>& kv) {
+                                 [](const std::pair<Int_t, const Neuland::Digitizing::Paddle*>& kv) {
                                      return kv.second->HasHalfFired();
                                  }));
 
     hMultTwo->Fill(std::count_if(paddles.begin(),
                                  paddles.end(),
-                                 [](const std::pair<const Int_t, std::unique_ptr<Neuland::Digitizing::Paddle>>& kv) {
+                                 [](const std::pair<Int_t, const Neuland::Digitizing::Paddle*>& kv) {
                                      return kv.second->HasFired();
                                  }));
 
@@ -164,7 +174,7 @@ void R3BNeulandDigitizer::Exec(Option_t*)
 
         if (fHitFilters.IsValid(hit))
         {
-            fHits.Insert(std::move(hit));
+            fHits.Emplace(std::move(hit));
         }
     } // loop over paddles
 
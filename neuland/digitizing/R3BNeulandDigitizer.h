@@ -21,6 +21,8 @@
 #include "R3BNeulandHit.h"
 #include "R3BNeulandPoint.h"
 #include "TCAConnector.h"
+#include "TVector3.h"
+#include <vector>
 
 class TGeoNode;
 class TH1F;
@@ -71,6 +73,12 @@ class R3BNeulandDigitizer : public FairTask
 
     Filterable<R3BNeulandHit&> fHitFilters;
 
+    // Points with energy deposition in the current event, kept to avoid reallocation
+    std::vector<const R3BNeulandPoint*> fDepositingPoints;
+    std::vector<Int_t> fPaddleIDs;
+    std::vector<TVector3> fPositions;
+    std::vector<Double_t> fDists;
+
     R3BNeulandGeoPar* fNeulandGeoPar; // non-owning
 
     TH1F* hMultOne;
@@ -0,0 +1,167 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "RandomForest.h"
+#include <fstream>
+#include <stdexcept>
+
+namespace Neuland
+{
+    RandomForest::RandomForest(const std::string& fileName) { Load(fileName); }
+
+    void RandomForest::Load(const std::string& fileName)
+    {
+        std::ifstream in(fileName);
+        if (!in.is_open())
+        {
+            throw std::runtime_error("RandomForest: Could not open model file " + fileName);
+        }
+        Load(in);
+    }
+
+    void RandomForest::Load(std::istream& in)
+    {
+        // Parse into a new forest, such that nothing is changed if the model is invalid
+        RandomForest forest;
+        forest.Parse(in);
+        *this = std::move(forest);
+    }
+
+    void RandomForest::Parse(std::istream& in)
+    {
+        const auto fail = [](const std::string& what) { throw std::runtime_error("RandomForest: " + what); };
+
+        std::string magic;
+        Int_t version = 0;
+        in >> magic >> version;
+        if (!in || magic != "R3BRandomForest")
+        {
+            fail("Not a random forest model");
+        }
+        if (version != Version)
+        {
+            fail("Model has format version " + std::to_string(version) + ", expected " + std::to_string(Version));
+        }
+
+        size_t nClasses = 0;
+        size_t nTrees = 0;
+        in >> fNFeatures >> nClasses >> nTrees;
+        if (!in || fNFeatures == 0 || nClasses == 0 || nTrees == 0)
+        {
+            fail("Invalid model dimensions");
+        }
+
+        fClasses.resize(nClasses);
+        for (auto& c : fClasses)
+        {
+            in >> c;
+        }
+
+        for (size_t tree = 0; tree < nTrees; tree++)
+        {
+            size_t nNodes = 0;
+            in >> nNodes;
+            if (!in || nNodes == 0)
+            {
+                fail("Invalid number of nodes in tree " + std::to_string(tree));
+            }
+
+            const UInt_t root = fNodes.size();
+            fRoots.push_back(root);
+            for (size_t i = 0; i < nNodes; i++)
+            {
+                Int_t left = 0;
+                in >> left;
+
+                Node node;
+                if (left < 0)
+                {
+                    node.feature = -1;
+                    node.threshold = 0.;
+                    node.left = fLeafValues.size();
+                    node.right = 0;
+                    for (size_t c = 0; c < nClasses; c++)
+                    {
+                        Double_t p = 0.;
+                        in >> p;
+                        fLeafValues.push_back(p);
+                    }
+                }
+                else
+                {
+                    Int_t right = 0;
+                    in >> right >> node.feature >> node.threshold;
+                    // Children always follow their parent, which also rules out loops
+                    if (left <= (Int_t)i || left >= (Int_t)nNodes || right <= (Int_t)i || right >= (Int_t)nNodes ||
+                        node.feature < 0 || node.feature >= (Int_t)fNFeatures)
+                    {
+                        fail("Invalid node " + std::to_string(i) + " in tree " + std::to_string(tree));
+                    }
+                    node.left = root + left;
+                    node.right = root + right;
+                }
+                fNodes.push_back(node);
+            }
+            if (!in)
+            {
+                fail("Unexpected end of model in tree " + std::to_string(tree));
+            }
+        }
+    }
+
+    void RandomForest::PredictProba(const std::vector<Double_t>& features, std::vector<Double_t>& proba) const
+    {
+        if (fRoots.empty())
+        {
+            throw std::runtime_error("RandomForest: No model loaded");
+        }
+        if (features.size() % fNFeatures != 0)
+        {
+            throw std::invalid_argument("RandomForest: Number of features is not a multiple of " +
+                                        std::to_string(fNFeatures));
+        }
+
+        const size_t nSamples = features.size() / fNFeatures;
+        const size_t nClasses = fClasses.size();
+        proba.assign(nSamples * nClasses, 0.);
+
+        // Tree by tree, such that each tree is only loaded once for all samples
+        for (const auto root : fRoots)
+        {
+            for (size_t s = 0; s < nSamples; s++)
+            {
+                const Double_t* x = &features[s * fNFeatures];
+                const Node* node = &fNodes[root];
+                while (node->feature >= 0)
+                {
+                    // scikit-learn evaluates trees in single precision
+                    const Double_t value = static_cast<Float_t>(x[node->feature]);
+                    node = &fNodes[value <= node->threshold ? node->left : node->right];
+                }
+
+                const Double_t* p = &fLeafValues[node->left];
+                Double_t* out = &proba[s * nClasses];
+                for (size_t c = 0; c < nClasses; c++)
+                {
+                    out[c] += p[c];
+                }
+            }
+        }
+
+        const Double_t nTrees = fRoots.size();
+        for (auto& p : proba)
+        {
+            p /= nTrees;
+        }
+    }
+} // namespace Neuland
@@ -0,0 +1,81 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3BROOT_NEULANDRANDOMFOREST_H
+#define R3BROOT_NEULANDRANDOMFOREST_H
+
+/**
+ * Evaluator for random forest classifiers trained with scikit-learn
+ *
+ * The model is exported once from Python with export_random_forest.py and loaded here, such that no Python
+ * interpreter is needed during reconstruction. Probabilities are identical to the ones of predict_proba: Features
+ * are compared in single precision like in scikit-learn, and the trees are summed up in the same order.
+ *
+ * File format (text, whitespace separated):
+ *   R3BRandomForest <version>
+ *   <number of features> <number of classes> <number of trees>
+ *   <class labels>
+ *   For each tree: <number of nodes>, followed by one entry per node, the root first:
+ *     Split node: <index of left child> <index of right child> <feature> <threshold>
+ *     Leaf:       -1 <probability of each class>
+ */
+
+#include "Rtypes.h"
+#include <istream>
+#include <string>
+#include <vector>
+
+namespace Neuland
+{
+    class RandomForest
+    {
+      public:
+        static constexpr Int_t Version = 1;
+
+        RandomForest() = default;
+        explicit RandomForest(const std::string& fileName);
+
+        // Throws std::runtime_error if the model can not be read
+        void Load(const std::string& fileName);
+        void Load(std::istream& in);
+
+        size_t GetNFeatures() const { return fNFeatures; }
+        size_t GetNClasses() const { return fClasses.size(); }
+        size_t GetNTrees() const { return fRoots.size(); }
+        const std::vector<Int_t>& GetClasses() const { return fClasses; }
+
+        // Scores many samples in one pass
+        // features: nSamples * nFeatures values, the features of each sample in turn
+        // proba: (return) nSamples * nClasses probabilities, the probabilities of each sample in turn
+        void PredictProba(const std::vector<Double_t>& features, std::vector<Double_t>& proba) const;
+
+      private:
+        void Parse(std::istream& in);
+
+        struct Node
+        {
+            Int_t feature; // -1 for leafs
+            Double_t threshold;
+            UInt_t left;  // Leafs: Offset of the class probabilities in fLeafValues
+            UInt_t right; //
+        };
+
+        size_t fNFeatures = 0;
+        std::vector<Int_t> fClasses;
+        std::vector<Node> fNodes;     // Nodes of all trees, each tree is contiguous
+        std::vector<UInt_t> fRoots;   // Index of the root node of each tree
+        std::vector<Double_t> fLeafValues;
+    };
+} // namespace Neuland
+
+#endif // R3BROOT_NEULANDRANDOMFOREST_H
@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+##############################################################################
+#   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    #
+#   Copyright (C) 2019 Members of R3B Collaboration                          #
+#                                                                            #
+#             This software is distributed under the terms of the            #
+#                 GNU General Public Licence (GPL) version 3,                #
+#                    copied verbatim in the file "LICENSE".                  #
+#                                                                            #
+# In applying this license GSI does not waive the privileges and immunities  #
+# granted to it by virtue of its status as an Intergovernmental Organization #
+# or submit itself to any jurisdiction.                                      #
+##############################################################################
+
+"""Export a pickled scikit-learn RandomForestClassifier for Neuland::RandomForest
+
+Usage: export_random_forest.py model.pkl model.txt
+
+Leaf probabilities are normalized here exactly like in predict_proba and all
+numbers are written with full precision, such that the C++ evaluation gives
+identical results.
+"""
+
+import sys
+
+import joblib
+import numpy as np
+
+VERSION = 1
+
+
+def export(model, out):
+    if getattr(model, "n_outputs_", 1) != 1:
+        raise ValueError("Only single output classifiers are supported")
+    n_features = getattr(model, "n_features_in_", None)
+    if n_features is None:
+        n_features = model.n_features_
+    n_classes = int(model.n_classes_)
+    classes = [int(c) for c in model.classes_]
+
+    out.write("R3BRandomForest {}\n".format(VERSION))
+    out.write("{} {} {}\n".format(n_features, n_classes, len(model.estimators_)))
+    out.write(" ".join(str(c) for c in classes) + "\n")
+
+    for estimator in model.estimators_:
+        tree = estimator.tree_
+        out.write("{}\n".format(tree.node_count))
+        for i in range(tree.node_count):
+            left = int(tree.children_left[i])
+            if left == -1:
+                # Same normalization as in ForestClassifier.predict_proba
+                proba = np.array(tree.value[i, 0, :n_classes], dtype=np.float64)
+                normalizer = proba.sum()
+                if normalizer == 0.0:
+                    normalizer = 1.0
+                proba /= normalizer
+                out.write("-1 " + " ".join(repr(float(p)) for p in proba) + "\n")
+            else:
+                out.write(
+                    "{} {} {} {}\n".format(
+                        left, int(tree.children_right[i]), int(tree.feature[i]), repr(float(tree.threshold[i]))
+                    )
+                )
+
+
+if __name__ == "__main__":
+    if len(sys.argv) != 3:
+        sys.exit(__doc__)
+    with open(sys.argv[2], "w") as f:
+        export(joblib.load(sys.argv[1]), f)
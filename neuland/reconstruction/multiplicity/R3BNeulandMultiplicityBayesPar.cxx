@@ -102,6 +102,63 @@ R3BNeulandMultiplicity::MultiplicityProbabilities R3BNeulandMultiplicityBayesPar
     return mult;
 }
 
+void R3BNeulandMultiplicityBayesPar::GetProbabilities(
+    const Features& features,
+    std::vector<R3BNeulandMultiplicity::MultiplicityProbabilities>& probabilities) const
+{
+    if (!fIsProperlyLoaded)
+    {
+        fIsProperlyLoaded = CheckIfProperlyLoaded();
+    }
+
+    const size_t nEvents = features.Size();
+    if (features.nClusters.size() != nEvents || features.Edep.size() != nEvents)
+    {
+        LOG(FATAL) << "R3BNeulandMultiplicityBayesPar::GetProbabilities: Feature columns differ in length";
+        return;
+    }
+    probabilities.assign(nEvents, R3BNeulandMultiplicity::MultiplicityProbabilities{});
+
+    // Entries outside of the histograms count as zero, like with TArrayI::At
+    const auto get = [](const TArrayI& a, const int i) { return (i >= 0 && i < a.GetSize()) ? a.GetArray()[i] : 0; };
+
+    // One multiplicity for all events at a time, such that each histogram is only walked once
+    for (int i = 0; i < NEULAND_MAX_MULT; i++)
+    {
+        const TArrayI& hits = fHits.at(i);
+        const TArrayI& clusters = fClusters.at(i);
+        const TArrayI& edep = fEdep.at(i);
+        for (size_t e = 0; e < nEvents; e++)
+        {
+            if (features.nHits[e] != 0)
+            {
+                probabilities[e][i] = (double)get(hits, features.nHits[e]) *
+                                      (double)get(clusters, features.nClusters[e]) *
+                                      (double)get(edep, features.Edep[e] / 10);
+            }
+        }
+    }
+
+    // Normalize so sum prob = 1
+    for (size_t e = 0; e < nEvents; e++)
+    {
+        if (features.nHits[e] == 0)
+        {
+            continue;
+        }
+        auto& mult = probabilities[e];
+        double sum = 0;
+        for (const double p : mult)
+        {
+            sum += p;
+        }
+        for (double& p : mult)
+        {
+            p /= sum;
+        }
+    }
+}
+
 bool R3BNeulandMultiplicityBayesPar::CheckIfProperlyLoaded() const
 {
     if (std::accumulate(fHits.cbegin(), fHits.cend(), 0, [](int i, const TArrayI& a) { return i + a.GetSum(); }) < 1)
@@ -19,10 +19,33 @@
 #include "R3BNeulandMultiplicity.h"
 #include "TArrayI.h"
 #include <array>
+#include <vector>
 
 class R3BNeulandMultiplicityBayesPar : public FairParGenericSet
 {
   public:
+    // Event features of many events in columns, e.g. for evaluating large samples at once
+    struct Features
+    {
+        std::vector<int> nHits;
+        std::vector<int> nClusters;
+        std::vector<int> Edep;
+
+        void Add(int h, int c, int e)
+        {
+            nHits.push_back(h);
+            nClusters.push_back(c);
+            Edep.push_back(e);
+        }
+        void Clear()
+        {
+            nHits.clear();
+            nClusters.clear();
+            Edep.clear();
+        }
+        size_t Size() const { return nHits.size(); }
+    };
+
     R3BNeulandMultiplicityBayesPar(const char* name = "R3BNeulandMultiplicityBayesPar",
                                    const char* title = "Neuland Multiplicity Bayes Parameters",
                                    const char* context = "TestDefaultContext");
@@ -36,6 +59,9 @@ class R3BNeulandMultiplicityBayesPar : public FairParGenericSet
     void Fill(int n, int nHits, int nClusters, int Edep);
     bool CheckIfProperlyLoaded() const;
     R3BNeulandMultiplicity::MultiplicityProbabilities GetProbabilities(int nHits, int nClusters, int Edep) const;
+    // Same as above for all events at once, probabilities is resized to the number of events
+    void GetProbabilities(const Features& features,
+                          std::vector<R3BNeulandMultiplicity::MultiplicityProbabilities>& probabilities) const;
 
   private:
     std::array<TArrayI, NEULAND_MAX_MULT> fHits;
@@ -43,9 +43,9 @@ void R3BNeulandMultiplicityBayesTrain::SetParContainers()
 
 void R3BNeulandMultiplicityBayesTrain::Exec(Option_t*)
 {
-    const int nPN = fTracks.Retrieve().size();
+    const int nPN = fTracks.View().size();
 
-    const auto clusters = fClusters.Retrieve();
+    const auto clusters = fClusters.View();
     const int nClusters = clusters.size();
 
     if (nClusters == 0)
@@ -54,9 +54,9 @@ void R3BNeulandMultiplicityBayesTrain::Exec(Option_t*)
     }
 
     const int nHits = std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0, [](size_t s, const R3BNeulandCluster* c) { return s + c->GetSize(); });
+        clusters.begin(), clusters.end(), 0, [](size_t s, const R3BNeulandCluster& c) { return s + c.GetSize(); });
     const int Edep = (int)std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0., [](Double_t s, const R3BNeulandCluster* c) { return s + c->GetE(); });
+        clusters.begin(), clusters.end(), 0., [](Double_t s, const R3BNeulandCluster& c) { return s + c.GetE(); });
 
     fPar->Fill(nPN, nHits, nClusters, Edep);
 }
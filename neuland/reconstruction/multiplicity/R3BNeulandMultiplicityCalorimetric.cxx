@@ -54,10 +54,10 @@ void R3BNeulandMultiplicityCalorimetric::Exec(Option_t*)
 {
     fMultiplicity->m.fill(0.);
 
-    const auto clusters = fClusters.Retrieve();
+    const auto clusters = fClusters.View();
     const auto Etot =
-        std::accumulate(clusters.cbegin(), clusters.cend(), 0., [](const Double_t a, const R3BNeulandCluster* b) {
-            return a + b->GetE();
+        std::accumulate(clusters.begin(), clusters.end(), 0., [](const Double_t a, const R3BNeulandCluster& b) {
+            return a + b.GetE();
         });
     const auto nClusters = clusters.size();
 
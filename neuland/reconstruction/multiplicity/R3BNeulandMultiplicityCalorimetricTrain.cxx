@@ -78,9 +78,9 @@ InitStatus R3BNeulandMultiplicityCalorimetricTrain::Init()
 
 void R3BNeulandMultiplicityCalorimetricTrain::Exec(Option_t*)
 {
-    const int nPN = fTracks.Retrieve().size();
+    const int nPN = fTracks.View().size();
 
-    const auto clusters = fClusters.Retrieve();
+    const auto clusters = fClusters.View();
     const int nClusters = clusters.size();
 
     if (nClusters == 0)
@@ -89,7 +89,7 @@ void R3BNeulandMultiplicityCalorimetricTrain::Exec(Option_t*)
     }
 
     const int Edep = (int)std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0., [](Double_t s, const R3BNeulandCluster* c) { return s + c->GetE(); });
+        clusters.begin(), clusters.end(), 0., [](Double_t s, const R3BNeulandCluster& c) { return s + c.GetE(); });
 
     GetOrBuildHist(nPN)->Fill(Edep, nClusters);
 }
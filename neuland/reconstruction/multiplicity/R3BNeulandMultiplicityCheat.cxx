@@ -32,7 +32,7 @@ InitStatus R3BNeulandMultiplicityCheat::Init()
 void R3BNeulandMultiplicityCheat::Exec(Option_t*)
 {
     fMultiplicity->m.fill(0.);
-    fMultiplicity->m[fPrimaryHits.Retrieve().size()] = 1.;
+    fMultiplicity->m[fPrimaryHits.View().size()] = 1.;
 }
 
 ClassImp(R3BNeulandMultiplicityCheat)
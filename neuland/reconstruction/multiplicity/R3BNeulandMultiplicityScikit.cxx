@@ -1,8 +1,8 @@
 #include "R3BNeulandMultiplicityScikit.h"
 #include "FairLogger.h"
 #include "FairRootManager.h"
-#include "TPython.h"
 #include <numeric>
+#include <stdexcept>
 #include <utility>
 
 R3BNeulandMultiplicityScikit::R3BNeulandMultiplicityScikit(TString model, TString input, TString output)
@@ -10,15 +10,14 @@ R3BNeulandMultiplicityScikit::R3BNeulandMultiplicityScikit(TString model, TStrin
     , fClusters(std::move(input))
     , fMultiplicity(new R3BNeulandMultiplicity())
     , fOutputName(std::move(output))
+    , fModel(model.Data())
 {
-    TPython::Exec("import sys; v = sys.version.replace('\\n', '')");
-    TPython::Exec("print(f'R3BNeulandMultiplicityScikit running TPython with Python version {v}')");
-
-    TPython::Exec("import numpy as np; import joblib; multmodel = joblib.load('" + model + "')");
-    // Note: ModuleNotFoundError: No module named 'sklearn. ...' -> That means wrong python version!
-
-    TPython::Exec("import ROOT; mult = ROOT.R3BNeulandMultiplicity()");
-    TPython::Bind(fMultiplicity, "mult"); // Bind here to prevent 1st event missing
+    LOG(INFO) << "R3BNeulandMultiplicityScikit: Loaded model " << model << " with " << fModel.GetNTrees() << " trees";
+    if (fModel.GetNFeatures() != 3)
+    {
+        throw std::runtime_error(
+            ("R3BNeulandMultiplicityScikit: Model " + model + " does not take 3 event features").Data());
+    }
 }
 
 R3BNeulandMultiplicityScikit::~R3BNeulandMultiplicityScikit() { delete fMultiplicity; }
@@ -43,7 +42,7 @@ InitStatus R3BNeulandMultiplicityScikit::Init()
 void R3BNeulandMultiplicityScikit::Exec(Option_t*)
 {
     fMultiplicity->m.fill(0.);
-    const auto clusters = fClusters.Retrieve();
+    const auto clusters = fClusters.View();
     const int nClusters = clusters.size();
 
     if (nClusters == 0)
@@ -54,24 +53,27 @@ void R3BNeulandMultiplicityScikit::Exec(Option_t*)
     }
 
     const int nHits = std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0, [](size_t s, const R3BNeulandCluster* c) { return s + c->GetSize(); });
+        clusters.begin(), clusters.end(), 0, [](size_t s, const R3BNeulandCluster& c) { return s + c.GetSize(); });
     const int Edep = (int)std::accumulate(
-        clusters.cbegin(), clusters.cend(), 0., [](Double_t s, const R3BNeulandCluster* c) { return s + c->GetE(); });
+        clusters.begin(), clusters.end(), 0., [](Double_t s, const R3BNeulandCluster& c) { return s + c.GetE(); });
 
-    // Use model to predict probabilities. Note: In the model tested here, no case "0" -> i + 1
-    TPython::Exec(
-        TString::Format("for i, p in enumerate(multmodel.predict_proba([[%d, %d, %d]])[0]):\n    mult.m[i + 1] = p",
-                        nHits,
-                        nClusters,
-                        Edep));
+    // Use model to predict probabilities
+    fFeatures = { Double_t(nHits), Double_t(nClusters), Double_t(Edep) };
+    fModel.PredictProba(fFeatures, fProba);
 
-    // Python -> C++ -> Autosave in branch
-    TPython::Bind(fMultiplicity, "mult");
+    // The class labels are the multiplicities. Note: In the model tested here, there is no class "0".
+    const auto& classes = fModel.GetClasses();
+    for (size_t i = 0; i < classes.size(); i++)
+    {
+        if (classes[i] >= 0 && classes[i] < (Int_t)fMultiplicity->m.size())
+        {
+            fMultiplicity->m[classes[i]] = fProba[i];
+        }
+    }
 
     // Log
     if (FairLogger::GetLogger()->IsLogNeeded(fair::Severity::debug))
     {
-        TPython::Exec("print([p for p in mult.m])");
         LOG(debug) << "R3BNeulandMultiplicityScikit::Exec "
                    << std::accumulate(fMultiplicity->m.cbegin(),
                                       fMultiplicity->m.cend(),
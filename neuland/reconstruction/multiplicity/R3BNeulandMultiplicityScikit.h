@@ -4,7 +4,16 @@
 #include "FairTask.h"
 #include "R3BNeulandCluster.h"
 #include "R3BNeulandMultiplicity.h"
+#include "RandomForest.h"
 #include "TCAConnector.h"
+#include <vector>
+
+/**
+ * NeuLAND multiplicity from a random forest classifier trained with scikit-learn
+ *
+ * The model has to be exported with export_random_forest.py. Features are the number of hits, the number of clusters
+ * and the total deposited energy, the class labels are the multiplicities.
+ */
 
 class R3BNeulandMultiplicityScikit : public FairTask
 {
@@ -24,6 +33,10 @@ class R3BNeulandMultiplicityScikit : public FairTask
     R3BNeulandMultiplicity* fMultiplicity;
     TString fOutputName;
 
+    Neuland::RandomForest fModel;    //!
+    std::vector<Double_t> fFeatures; //!
+    std::vector<Double_t> fProba;    //!
+
     ClassDefOverride(R3BNeulandMultiplicityScikit, 0)
 };
 
@@ -30,12 +30,12 @@ void R3BNeulandNeutronsCheat::Exec(Option_t*)
 {
     fNeutrons.Reset();
 
-    auto hits = fHits.Retrieve();
+    const auto hits = fHits.View();
     const auto mult = fMultiplicity->GetMultiplicity();
 
     for (size_t n = 0; n < hits.size() && n < mult; n++)
     {
-        fNeutrons.Insert(R3BNeulandNeutron(*hits.at(n)));
+        fNeutrons.Emplace(hits[n]);
     }
 }
 
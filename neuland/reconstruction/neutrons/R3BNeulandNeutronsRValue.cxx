@@ -2,6 +2,7 @@
 #include "FairLogger.h"
 #include "FairRootManager.h"
 #include <IsElastic.h>
+#include <algorithm>
 #include <utility>
 
 R3BNeulandNeutronsRValue::R3BNeulandNeutronsRValue(double EkinRefMeV,
@@ -47,15 +48,30 @@ void R3BNeulandNeutronsRValue::Exec(Option_t*)
     const auto mult = fMultiplicity->GetMultiplicity();
     for (size_t n = 0; n < clusters.size() && n < mult; n++)
     {
-        fNeutrons.Insert(R3BNeulandNeutron(*clusters.at(n)));
+        fNeutrons.Emplace(*clusters.at(n));
     }
 }
 
-void R3BNeulandNeutronsRValue::SortClustersByRValue(std::vector<R3BNeulandCluster*>& clusters) const
+void R3BNeulandNeutronsRValue::SortClustersByRValue(std::vector<R3BNeulandCluster*>& clusters)
 {
-    std::sort(clusters.begin(), clusters.end(), [&](const R3BNeulandCluster* a, const R3BNeulandCluster* b) {
-        return a->GetRECluster(fEkinRefMeV) < b->GetRECluster(fEkinRefMeV);
-    });
+    // Each R-Value requires a loop over all hits of the cluster, so compute them once instead of in every comparison
+    fRValues.clear();
+    fRValues.reserve(clusters.size());
+    for (const auto cluster : clusters)
+    {
+        fRValues.emplace_back(cluster->GetRECluster(fEkinRefMeV), cluster);
+    }
+
+    std::sort(fRValues.begin(),
+              fRValues.end(),
+              [](const std::pair<Double_t, R3BNeulandCluster*>& a, const std::pair<Double_t, R3BNeulandCluster*>& b) {
+                  return a.first < b.first;
+              });
+
+    for (size_t i = 0; i < clusters.size(); i++)
+    {
+        clusters[i] = fRValues[i].second;
+    }
 }
 
 void R3BNeulandNeutronsRValue::PrioritizeTimeWiseFirstCluster(std::vector<R3BNeulandCluster*>& clusters) const
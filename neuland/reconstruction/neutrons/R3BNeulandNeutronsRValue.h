@@ -6,6 +6,8 @@
 #include "R3BNeulandMultiplicity.h"
 #include "R3BNeulandNeutron.h"
 #include "TCAConnector.h"
+#include <utility>
+#include <vector>
 
 class R3BNeulandNeutronsRValue : public FairTask
 {
@@ -27,7 +29,9 @@ class R3BNeulandNeutronsRValue : public FairTask
     TCAInputConnector<R3BNeulandCluster> fClusters;  //!
     TCAOutputConnector<R3BNeulandNeutron> fNeutrons; //!
 
-    void SortClustersByRValue(std::vector<R3BNeulandCluster*>&) const;
+    std::vector<std::pair<Double_t, R3BNeulandCluster*>> fRValues; //! Reused between events
+
+    void SortClustersByRValue(std::vector<R3BNeulandCluster*>&);
     void PrioritizeTimeWiseFirstCluster(std::vector<R3BNeulandCluster*>&) const;
     void FilterClustersByEnergyDeposit(std::vector<R3BNeulandCluster*>&) const;
     void FilterClustersByKineticEnergy(std::vector<R3BNeulandCluster*>&) const;
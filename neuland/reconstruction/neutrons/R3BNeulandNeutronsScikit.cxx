@@ -1,10 +1,17 @@
 #include "R3BNeulandNeutronsScikit.h"
 #include "FairLogger.h"
 #include "FairRootManager.h"
-#include "TPython.h"
+#include <algorithm>
+#include <functional>
 #include <iostream>
+#include <stdexcept>
 #include <utility>
 
+namespace
+{
+    const size_t gNFeatures = 10;
+}
+
 R3BNeulandNeutronsScikit::R3BNeulandNeutronsScikit(TString model,
                                                    TString inputMult,
                                                    TString inputCluster,
@@ -16,37 +23,15 @@ R3BNeulandNeutronsScikit::R3BNeulandNeutronsScikit(TString model,
     , fClusters(nullptr)
     , fNeutrons(std::move(output))
     , fMinProb(0.1)
+    , fModel(model.Data())
 {
-    TPython::Exec("import sys; v = sys.version.replace('\\n', '')");
-    TPython::Exec("print(f'R3BNeulandNeutronsScikit running TPython with Python version {v}')");
-
-    TPython::Exec("import numpy as np; import joblib; model = joblib.load('" + model + "')");
-    // Note: ModuleNotFoundError: No module named 'sklearn.ensemble._forest' -> That means wrong python version!
-
-    TPython::Exec("import ROOT; tca = ROOT.TClonesArray(\"R3BNeulandCluster\")");
-
-    // Example to test model:
-    // double prob = (Double_t)TPython::Eval("model.predict_proba([[63.421486, 1.582491, 1.0, 621.388550, 8.881784e-16,
-    // 0.000000, 1.582491, -18.501257, -7.500000, 1522.5]])[0][1]");
-
-    // Share single cluster between python and C++ **SLOW**
-    // TPython::Exec("import ROOT");
-    // TPython::Exec("cluster = ROOT.R3BNeulandCluster()");
-    // R3BNeulandCluster* cluster = ...
-    // TPython::Bind(cluster, "cluster");
-    // TString fPredictor = "model.predict_proba([["
-    //  "cluster.GetT(),\n"
-    //  "cluster.GetE(),\n"
-    //  "cluster.GetSize(),\n"
-    //  "cluster.GetEToF(),\n"
-    //  "cluster.GetEnergyMoment(),\n"
-    //  "cluster.GetLastHit().GetT() - cluster.GetFirstHit().GetT(),\n"
-    //  "cluster.GetMaxEnergyHit().GetE(),\n"
-    //  "cluster.GetPosition().X(),\n"
-    //  "cluster.GetPosition().Y(),\n"
-    //  "cluster.GetPosition().Z(),\n"
-    //  "]])[0][1]"
-    // double prob = (Double_t)TPython::Eval(fPredictor);
+    LOG(INFO) << "R3BNeulandNeutronsScikit: Loaded model " << model << " with " << fModel.GetNTrees() << " trees";
+    if (fModel.GetNFeatures() != gNFeatures || fModel.GetNClasses() < 2)
+    {
+        throw std::runtime_error(("R3BNeulandNeutronsScikit: Model " + model +
+                                  " does not take 10 cluster features or has less than two classes")
+                                     .Data());
+    }
 }
 
 InitStatus R3BNeulandNeutronsScikit::Init()
@@ -87,24 +72,37 @@ void R3BNeulandNeutronsScikit::Exec(Option_t*)
         return;
     }
 
-    // Let Python know about the new clusters
-    TPython::Bind(fClusters, "tca");
-    TPython::Exec("data = np.array([[cluster.GetT(), cluster.GetE(), cluster.GetSize(), cluster.GetEToF(), "
-                  "cluster.GetEnergyMoment(), (cluster.GetLastHit().GetT() - cluster.GetFirstHit().GetT()),  "
-                  "cluster.GetMaxEnergyHit().GetE(), cluster.GetPosition().X(), cluster.GetPosition().Y(), "
-                  "cluster.GetPosition().Z()] for cluster in tca])");
+    // Features of all clusters in turn
+    const int nClusters = fClusters->GetEntries();
+    fFeatures.clear();
+    fFeatures.reserve(nClusters * gNFeatures);
+    for (int i = 0; i < nClusters; i++)
+    {
+        const auto cluster = (R3BNeulandCluster*)fClusters->At(i);
+        const TVector3 position = cluster->GetPosition();
+        fFeatures.insert(fFeatures.end(),
+                         { cluster->GetT(),
+                           cluster->GetE(),
+                           Double_t(cluster->GetSize()),
+                           cluster->GetEToF(),
+                           cluster->GetEnergyMoment(),
+                           cluster->GetLastHit().GetT() - cluster->GetFirstHit().GetT(),
+                           cluster->GetMaxEnergyHit().GetE(),
+                           position.X(),
+                           position.Y(),
+                           position.Z() });
+    }
 
-    // Use model to predict probabilities - **SLOW**
-    TPython::Exec("results = model.predict_proba(data)[:, 1]");
+    // Use model to predict probabilities for all clusters at once
+    fModel.PredictProba(fFeatures, fProba);
 
     //// Make a new container with scored clusters
     std::vector<ClusterWithProba> cwps;
-    const int nClusters = fClusters->GetEntries();
+    const size_t nClasses = fModel.GetNClasses();
     cwps.reserve(nClusters);
     for (int i = 0; i < nClusters; i++)
     {
-        cwps.emplace_back(ClusterWithProba{ (R3BNeulandCluster*)fClusters->At(i),
-                                            (Double_t)TPython::Eval(TString::Format("results[%d]", i)) });
+        cwps.emplace_back(ClusterWithProba{ (R3BNeulandCluster*)fClusters->At(i), fProba[i * nClasses + 1] });
     }
 
     // Sort scored clusters, high probability first
@@ -126,7 +124,7 @@ void R3BNeulandNeutronsScikit::Exec(Option_t*)
     {
         if (cwps.at(n).p > fMinProb)
         {
-            fNeutrons.Insert(R3BNeulandNeutron(*(cwps.at(n).c)));
+            fNeutrons.Emplace(*(cwps.at(n).c));
         }
     }
 }
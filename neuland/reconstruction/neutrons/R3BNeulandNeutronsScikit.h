@@ -5,8 +5,18 @@
 #include "R3BNeulandCluster.h"
 #include "R3BNeulandMultiplicity.h"
 #include "R3BNeulandNeutron.h"
+#include "RandomForest.h"
 #include "TCAConnector.h"
 #include "TClonesArray.h"
+#include <vector>
+
+/**
+ * NeuLAND neutron selection with a random forest classifier trained with scikit-learn
+ *
+ * The model has to be exported with export_random_forest.py. For each cluster, the probability of the second class
+ * (being a first interaction point) is used to select the n clusters with the highest probability, with the
+ * multiplicity n taken from another task.
+ */
 
 class R3BNeulandNeutronsScikit : public FairTask
 {
@@ -32,9 +42,10 @@ class R3BNeulandNeutronsScikit : public FairTask
 
     TCAOutputConnector<R3BNeulandNeutron> fNeutrons; //!
     double fMinProb;
-    // const TString fPredictor;                        //!
-    // const boost::format fFormatter; //!
-    // const char* fFmt; //!
+
+    Neuland::RandomForest fModel;    //!
+    std::vector<Double_t> fFeatures; //!
+    std::vector<Double_t> fProba;    //!
 
     struct ClusterWithProba
     {
@@ -15,20 +15,47 @@
 #define NEULANDCLUSTERINGENGINEH
 
 #include <algorithm>
+#include <array>
 #include <functional>
+#include <unordered_map>
 #include <vector>
 
 namespace Neuland
 {
 
-    template <typename T>
+    /* Clusters a vector of objects: Two objects belong to the same cluster if the clustering condition is true for
+     * them, or if they are linked by a chain of such objects.
+     * The clustering condition can be any callable type. Passing e.g. a functor type instead of the default
+     * std::function allows the compiler to inline it.
+     * Optionally, objects can be sorted into cells of a grid (e.g. in position and time). If the clustering condition
+     * is only ever true for objects in the same or in neighboring cells, only those are compared, which makes
+     * clustering near-linear in the number of objects instead of quadratic. The result is the same in both cases. */
+    template <typename T, typename BinaryPredicate = std::function<bool(const T&, const T&)>>
     class ClusteringEngine
     {
         using Tit = typename std::vector<T>::iterator;
-        using BinaryPredicate = std::function<bool(const T&, const T&)>;
+
+      public:
+        /* Integer grid coordinates, e.g. of position and time. Unused dimensions can be left at 0. */
+        using Cell = std::array<long, 4>;
+        using CellFunction = std::function<Cell(const T&)>;
 
       private:
         BinaryPredicate f;
+        CellFunction cellOf;
+
+        struct CellHash
+        {
+            size_t operator()(const Cell& c) const
+            {
+                size_t h = 0;
+                for (const auto& x : c)
+                {
+                    h = h * 1000003 ^ std::hash<long>()(x);
+                }
+                return h;
+            }
+        };
 
         /* Partitions an already divided range by clustering both the items in the first part AND the items added to the
          * first part during this process with the items in the second part.
@@ -47,6 +74,121 @@ namespace Neuland
             return moving_divider;
         }
 
+        /* Same as Clusterize, but only compares objects in neighboring cells. To produce exactly the same clusters in
+         * the same order, the objects are not moved until the end. Instead, their positions are tracked and the swaps
+         * std::partition would perform are replayed on the matches: The i-th non-matching object in front of the new
+         * divider is exchanged with the i-th matching object behind it, counted from the back. */
+        std::vector<std::vector<T>> ClusterizeBinned(std::vector<T>& from) const
+        {
+            const size_t n = from.size();
+            std::vector<Cell> cells(n);
+            std::vector<size_t> idAt(n);  // Object at each position of the (virtually) partitioned vector
+            std::vector<size_t> posOf(n); // Position of each object
+            std::vector<size_t> slotOf(n);  // Position of each object in its bin
+            std::unordered_map<Cell, size_t, CellHash> binOf;
+            std::vector<std::vector<size_t>> bins; // Not yet clustered objects per cell
+
+            for (size_t id = 0; id < n; id++)
+            {
+                cells[id] = cellOf(from[id]);
+                idAt[id] = id;
+                posOf[id] = id;
+                const auto it = binOf.emplace(cells[id], bins.size()).first;
+                if (it->second == bins.size())
+                {
+                    bins.emplace_back();
+                }
+                slotOf[id] = bins[it->second].size();
+                bins[it->second].push_back(id);
+            }
+
+            const auto removeFromBin = [&](const size_t id) {
+                auto& bin = bins[binOf.find(cells[id])->second];
+                bin[slotOf[id]] = bin.back();
+                slotOf[bin.back()] = slotOf[id];
+                bin.pop_back();
+            };
+
+            std::vector<size_t> matches;
+            std::vector<size_t> ends; // Cluster boundaries
+            size_t divider = 0;
+            while (divider != n)
+            {
+                removeFromBin(idAt[divider]);
+                divider++;
+                for (size_t a = ends.empty() ? 0 : ends.back(); a != divider; a++)
+                {
+                    const size_t seed = idAt[a];
+                    matches.clear();
+                    Cell neighbor;
+                    for (int i = 0; i < 81; i++)
+                    {
+                        for (int dim = 0, code = i; dim < 4; dim++, code /= 3)
+                        {
+                            neighbor[dim] = cells[seed][dim] + code % 3 - 1;
+                        }
+                        const auto bin = binOf.find(neighbor);
+                        if (bin == binOf.end())
+                        {
+                            continue;
+                        }
+                        for (const size_t id : bins[bin->second])
+                        {
+                            if (f(from[seed], from[id]))
+                            {
+                                matches.push_back(posOf[id]);
+                            }
+                        }
+                    }
+                    if (matches.empty())
+                    {
+                        continue;
+                    }
+
+                    std::sort(matches.begin(), matches.end());
+                    const size_t newDivider = divider + matches.size();
+                    auto back = matches.end();
+                    auto match = matches.begin();
+                    for (size_t pos = divider; pos != newDivider; pos++)
+                    {
+                        if (match != matches.end() && *match == pos)
+                        {
+                            ++match;
+                            continue;
+                        }
+                        --back;
+                        const size_t other = idAt[*back];
+                        idAt[*back] = idAt[pos];
+                        posOf[idAt[pos]] = *back;
+                        idAt[pos] = other;
+                        posOf[other] = pos;
+                    }
+                    for (size_t pos = divider; pos != newDivider; pos++)
+                    {
+                        removeFromBin(idAt[pos]);
+                    }
+                    divider = newDivider;
+                }
+                ends.push_back(divider);
+            }
+
+            std::vector<std::vector<T>> out;
+            out.reserve(ends.size());
+            size_t begin = 0;
+            for (const size_t end : ends)
+            {
+                std::vector<T> cluster;
+                cluster.reserve(end - begin);
+                for (size_t pos = begin; pos != end; pos++)
+                {
+                    cluster.push_back(std::move(from[idAt[pos]]));
+                }
+                out.push_back(std::move(cluster));
+                begin = end;
+            }
+            return out;
+        }
+
       public:
         /* Default Constructor. Note: If the clustering condition is not set, a "bad_function_call" will be thrown upon
          * calling clusterize. This seems better than providing a default function which might produce hard-to-track
@@ -59,10 +201,19 @@ namespace Neuland
 
         void SetClusteringCondition(const BinaryPredicate& _f) { f = _f; }
 
+        /* Sort objects into cells before clustering. The clustering condition must be false for any two objects whose
+         * cells differ by more than one in any dimension. An empty function disables binning. */
+        void SetCellFunction(const CellFunction& _cellOf) { cellOf = _cellOf; }
+
         bool SatisfiesClusteringCondition(const T& a, const T& b) const { return f(a, b); }
 
         std::vector<std::vector<T>> Clusterize(std::vector<T>& from) const
         {
+            if (cellOf)
+            {
+                return ClusterizeBinned(from);
+            }
+
             std::vector<std::vector<T>> out;
 
             /* Three iterators (read: markers for positions in the input vector) are required:
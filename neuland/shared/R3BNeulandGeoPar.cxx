@@ -17,12 +17,16 @@
 #include "TVector3.h"
 #include <algorithm>
 #include <iostream>
+#include <stdexcept>
+#include <string>
 
 #include "FairParamList.h"
 
 R3BNeulandGeoPar::R3BNeulandGeoPar(const char* name, const char* title, const char* context)
     : FairParGenericSet(name, title, context)
     , fNeulandGeoNode(nullptr)
+    , fNeulandTransform()
+    , fNPaddles(0)
 {
 }
 
@@ -31,6 +35,19 @@ R3BNeulandGeoPar::~R3BNeulandGeoPar()
     // Note: Deleting stuff here or in clear() causes segfaults?
 }
 
+Bool_t R3BNeulandGeoPar::init(FairParIo* input)
+{
+    if (!FairParGenericSet::init(input))
+    {
+        return kFALSE;
+    }
+    if (fNeulandGeoNode)
+    {
+        BuildPaddleLookup();
+    }
+    return kTRUE;
+}
+
 void R3BNeulandGeoPar::clear() {}
 
 void R3BNeulandGeoPar::putParams(FairParamList* l)
@@ -82,47 +99,80 @@ Double_t R3BNeulandGeoPar::GetPaddleHalfLength() const
     return ((TGeoBBox*)fNeulandGeoNode->GetDaughter(0)->GetVolume()->GetShape())->GetDX();
 }
 
+namespace
+{
+    // Inverse of a rotation matrix is its transpose
+    inline void MasterToLocal(const Double_t* rot, const Double_t* trans, const Double_t* master, Double_t* local)
+    {
+        const Double_t d[3] = { master[0] - trans[0], master[1] - trans[1], master[2] - trans[2] };
+        for (Int_t i = 0; i < 3; i++)
+        {
+            local[i] = rot[i] * d[0] + rot[i + 3] * d[1] + rot[i + 6] * d[2];
+        }
+    }
+
+    inline void LocalToMaster(const Double_t* rot, const Double_t* trans, const Double_t* local, Double_t* master)
+    {
+        for (Int_t i = 0; i < 3; i++)
+        {
+            master[i] = rot[3 * i] * local[0] + rot[3 * i + 1] * local[1] + rot[3 * i + 2] * local[2] + trans[i];
+        }
+    }
+} // namespace
+
 // Convert positions of e.g. points to the local coordinate of the respective paddle [(-135,135),(-2.5,2.5),(-2.5,2.5)]
 TVector3 R3BNeulandGeoPar::ConvertToLocalCoordinates(const TVector3& position, const Int_t paddleID) const
 {
-    Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
-    Double_t pos_tmp[3];
+    const Transform& t = GetPaddleTransform(paddleID);
+    const Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
     Double_t pos_out[3];
-
-    // First, convert to Neuland-local coordinates (consisting of all paddles)
-    fNeulandGeoNode->GetMatrix()->MasterToLocal(pos_in, pos_tmp);
-    // Second, convert to the repective paddle
-    fPaddleGeoNodes.at(paddleID)->MasterToLocal(pos_tmp, pos_out);
-
+    MasterToLocal(t.rot, t.trans, pos_in, pos_out);
     return TVector3(pos_out[0], pos_out[1], pos_out[2]);
 }
 
 TVector3 R3BNeulandGeoPar::ConvertToGlobalCoordinates(const TVector3& position, const Int_t paddleID) const
 {
-    Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
-    Double_t pos_tmp[3];
+    const Transform& t = GetPaddleTransform(paddleID);
+    const Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
     Double_t pos_out[3];
+    LocalToMaster(t.rot, t.trans, pos_in, pos_out);
+    return TVector3(pos_out[0], pos_out[1], pos_out[2]);
+}
 
-    // Note reverse order of Global->Local
-    fPaddleGeoNodes.at(paddleID)->LocalToMaster(pos_in, pos_tmp);
-
-    fNeulandGeoNode->GetMatrix()->LocalToMaster(pos_tmp, pos_out);
+Double_t R3BNeulandGeoPar::ConvertToLocalX(const TVector3& position, const Int_t paddleID) const
+{
+    // Projection on the paddle axis, i.e. the first column of the rotation
+    const Transform& t = GetPaddleTransform(paddleID);
+    return t.rot[0] * (position.X() - t.trans[0]) + t.rot[3] * (position.Y() - t.trans[1]) +
+           t.rot[6] * (position.Z() - t.trans[2]);
+}
 
-    return TVector3(pos_out[0], pos_out[1], pos_out[2]);
+void R3BNeulandGeoPar::ConvertToLocalX(const std::vector<Int_t>& paddleIDs,
+                                       const std::vector<TVector3>& positions,
+                                       std::vector<Double_t>& localX) const
+{
+    if (paddleIDs.size() != positions.size())
+    {
+        throw std::invalid_argument("R3BNeulandGeoPar::ConvertToLocalX: Number of paddle ids and positions differ");
+    }
+    localX.resize(positions.size());
+    for (size_t i = 0; i < positions.size(); i++)
+    {
+        localX[i] = ConvertToLocalX(positions[i], paddleIDs[i]);
+    }
 }
 
 TVector3 R3BNeulandGeoPar::ConvertGlobalToPixel(const TVector3& position) const
 {
     const Int_t nPixels = 50;
     const Double_t sizePixel = 5;
-    const Int_t nPaddles = fNeulandGeoNode->GetNdaughters();
-    const Int_t nPlanes = nPaddles / nPixels;
+    const Int_t nPlanes = fNPaddles / nPixels;
 
-    Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
+    const Double_t pos_in[3] = { position.X(), position.Y(), position.Z() };
     Double_t pos_tmp[3];
 
     // First, convert to Neuland-local coordinates (consisting of all paddles)
-    fNeulandGeoNode->GetMatrix()->MasterToLocal(pos_in, pos_tmp);
+    MasterToLocal(fNeulandTransform.rot, fNeulandTransform.trans, pos_in, pos_tmp);
 
     // Note: PaddleHalfLength is 135 (light guides)
     // Map x and y values with [-125.:125.] float to [0:nPixels-1] int
@@ -135,12 +185,48 @@ TVector3 R3BNeulandGeoPar::ConvertGlobalToPixel(const TVector3& position) const
     return TVector3(x, y, z);
 }
 
+const R3BNeulandGeoPar::Transform& R3BNeulandGeoPar::GetPaddleTransform(const Int_t paddleID) const
+{
+    if (paddleID < 0 || paddleID >= (Int_t)fHasPaddle.size() || !fHasPaddle[paddleID])
+    {
+        throw std::out_of_range("R3BNeulandGeoPar: No paddle with id " + std::to_string(paddleID));
+    }
+    return fPaddleTransforms[paddleID];
+}
+
 void R3BNeulandGeoPar::BuildPaddleLookup()
 {
+    fPaddleGeoNodes.clear();
+    fPaddleTransforms.clear();
+    fHasPaddle.clear();
+
+    const TGeoMatrix* neulandMatrix = fNeulandGeoNode->GetMatrix();
+    std::copy_n(neulandMatrix->GetRotationMatrix(), 9, fNeulandTransform.rot);
+    std::copy_n(neulandMatrix->GetTranslation(), 3, fNeulandTransform.trans);
+    fNPaddles = fNeulandGeoNode->GetNdaughters();
+
     for (Int_t i = 0; i < fNeulandGeoNode->GetNdaughters(); i++)
     {
         TGeoNode* node = fNeulandGeoNode->GetDaughter(i);
-        fPaddleGeoNodes[node->GetNumber()] = node;
+        const Int_t paddleID = node->GetNumber();
+        fPaddleGeoNodes[paddleID] = node;
+        if (paddleID < 0)
+        {
+            continue;
+        }
+
+        // Combined transformation paddle -> Neuland -> global
+        TGeoHMatrix matrix(*neulandMatrix);
+        matrix.Multiply(node->GetMatrix());
+
+        if (paddleID >= (Int_t)fHasPaddle.size())
+        {
+            fPaddleTransforms.resize(paddleID + 1);
+            fHasPaddle.resize(paddleID + 1, kFALSE);
+        }
+        std::copy_n(matrix.GetRotationMatrix(), 9, fPaddleTransforms[paddleID].rot);
+        std::copy_n(matrix.GetTranslation(), 3, fPaddleTransforms[paddleID].trans);
+        fHasPaddle[paddleID] = kTRUE;
     }
 }
 ClassImp(R3BNeulandGeoPar);
@@ -17,6 +17,7 @@
 #include "FairParGenericSet.h"
 #include "TGeoNode.h"
 #include <map>
+#include <vector>
 class FairParamList;
 class TVector3;
 
@@ -26,6 +27,8 @@ class TVector3;
  *
  * Stores the full Neuland geo node used in the simulation for later reference, especially for coordinate
  * transformation from and to local and global coordinates.
+ * When the geo node is set or read, the combined transformations of all paddles are precomputed into a table, such
+ * that the conversions do not need TGeo and can be used from several threads at once.
  */
 
 class R3BNeulandGeoPar : public FairParGenericSet
@@ -39,6 +42,8 @@ class R3BNeulandGeoPar : public FairParGenericSet
                      const char* context = "TestDefaultContext");
     ~R3BNeulandGeoPar() override;
 
+    // Builds the paddle lookup also after the container was streamed from a ROOT file, which bypasses getParams()
+    Bool_t init(FairParIo*) override;
     void clear() override;
     void putParams(FairParamList*) override;
     Bool_t getParams(FairParamList*) override;
@@ -52,9 +57,28 @@ class R3BNeulandGeoPar : public FairParGenericSet
     TVector3 ConvertToGlobalCoordinates(const TVector3& position, const Int_t paddleID) const;
     TVector3 ConvertGlobalToPixel(const TVector3& position) const;
 
+    // Only the position along the paddle, i.e. the local X-Coordinate
+    Double_t ConvertToLocalX(const TVector3& position, const Int_t paddleID) const;
+    // Same for all points of an event in one pass. localX is resized to the number of points.
+    void ConvertToLocalX(const std::vector<Int_t>& paddleIDs,
+                         const std::vector<TVector3>& positions,
+                         std::vector<Double_t>& localX) const;
+
   private:
+    // Local to global transformation: global = rot * local + trans, with rot in row-major order
+    struct Transform
+    {
+        Double_t rot[9];
+        Double_t trans[3];
+    };
+
     std::map<Int_t, TGeoNode*> fPaddleGeoNodes;
+    std::vector<Transform> fPaddleTransforms; //! Indexed by paddle id
+    std::vector<Bool_t> fHasPaddle;           //! Whether there is a paddle with this id
+    Transform fNeulandTransform;              //!
+    Int_t fNPaddles;                          //!
     void BuildPaddleLookup();
+    const Transform& GetPaddleTransform(Int_t paddleID) const;
 
     R3BNeulandGeoPar(const R3BNeulandGeoPar&);
     R3BNeulandGeoPar& operator=(const R3BNeulandGeoPar&);
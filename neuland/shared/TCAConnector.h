@@ -17,10 +17,89 @@
 #include "FairRootManager.h"
 #include "TClonesArray.h"
 #include "TString.h"
+#include <cstddef>
 #include <exception>
+#include <iterator>
 #include <utility>
 #include <vector>
 
+/* Non-owning, typed view of the objects in a TClonesArray, without copying pointers or objects.
+ * Only valid until the TClonesArray is changed, i.e. for the current event. */
+template <typename T>
+class TCAView
+{
+  public:
+    class iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        explicit iterator(TObject* const* p)
+            : fP(p)
+        {
+        }
+
+        T& operator*() const { return *static_cast<T*>(*fP); }
+        T* operator->() const { return static_cast<T*>(*fP); }
+        T& operator[](difference_type n) const { return *static_cast<T*>(fP[n]); }
+
+        iterator& operator++()
+        {
+            ++fP;
+            return *this;
+        }
+        iterator operator++(int) { return iterator(fP++); }
+        iterator& operator--()
+        {
+            --fP;
+            return *this;
+        }
+        iterator operator--(int) { return iterator(fP--); }
+        iterator& operator+=(difference_type n)
+        {
+            fP += n;
+            return *this;
+        }
+        iterator& operator-=(difference_type n)
+        {
+            fP -= n;
+            return *this;
+        }
+        iterator operator+(difference_type n) const { return iterator(fP + n); }
+        iterator operator-(difference_type n) const { return iterator(fP - n); }
+        difference_type operator-(const iterator& o) const { return fP - o.fP; }
+
+        bool operator==(const iterator& o) const { return fP == o.fP; }
+        bool operator!=(const iterator& o) const { return fP != o.fP; }
+        bool operator<(const iterator& o) const { return fP < o.fP; }
+
+      private:
+        TObject* const* fP = nullptr;
+    };
+
+    TCAView() = default;
+    explicit TCAView(const TClonesArray* tca)
+        : fBegin(tca == nullptr ? nullptr : tca->GetObjectRef())
+        , fSize(tca == nullptr ? 0 : tca->GetEntriesFast())
+    {
+    }
+
+    iterator begin() const { return iterator(fBegin); }
+    iterator end() const { return iterator(fBegin + fSize); }
+    size_t size() const { return fSize; }
+    bool empty() const { return fSize == 0; }
+    T& operator[](size_t i) const { return *static_cast<T*>(fBegin[i]); }
+
+  private:
+    TObject* const* fBegin = nullptr;
+    size_t fSize = 0;
+};
+
 template <typename T>
 class TCAInputConnector
 {
@@ -59,6 +138,16 @@ class TCAInputConnector
         }
     }
 
+    TCAView<T> View() const
+    {
+        if (fTCA == nullptr)
+        {
+            throw std::runtime_error(
+                ("TCAInputConnector: TClonesArray " + fBranchName + " of " + fClassName + "s not available").Data());
+        }
+        return TCAView<T>(fTCA);
+    }
+
     std::vector<T*> Retrieve() const
     {
         std::vector<T*> fV;
@@ -128,6 +217,9 @@ class TCAOptionalInputConnector
         }
     }
 
+    // Empty if the TClonesArray is not available
+    TCAView<T> View() const { return TCAView<T>(fTCA); }
+
     std::vector<T*> Retrieve() const
     {
         std::vector<T*> fV;
@@ -216,16 +308,20 @@ class TCAOutputConnector
         return fTCA->GetEntries();
     }
 
-    void Insert(T t)
+    // Constructs a new object directly in the TClonesArray, reusing its memory from previous events
+    template <typename... Args>
+    T& Emplace(Args&&... args)
     {
         if (fTCA == nullptr)
         {
             throw std::runtime_error(
                 ("TCAOutputConnector: TClonesArray " + fBranchName + " of " + fClassName + "s not available").Data());
         }
-        new ((*fTCA)[fTCA->GetEntries()]) T(std::move(t));
+        return *new ((*fTCA)[fTCA->GetEntriesFast()]) T(std::forward<Args>(args)...);
     }
 
+    void Insert(T t) { Emplace(std::move(t)); }
+
     void Insert(T* t)
     {
         if (fTCA == nullptr)
@@ -235,7 +331,7 @@ class TCAOutputConnector
         }
         if (t != nullptr)
         {
-            new ((*fTCA)[fTCA->GetEntries()]) T(*t);
+            Emplace(*t);
         }
     }
 
@@ -248,7 +344,7 @@ class TCAOutputConnector
         }
         for (auto& o : v)
         {
-            new ((*fTCA)[fTCA->GetEntries()]) T(std::move(o));
+            Emplace(std::move(o));
         }
         v.clear();
     }
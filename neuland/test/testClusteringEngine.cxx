@@ -58,6 +58,28 @@ namespace
         EXPECT_EQ(clusters, expected);
     }
 
+    TEST(testClusteringEngine, binned_clustering)
+    {
+        struct Condition
+        {
+            bool operator()(const int& a, const int& b) const { return std::abs(b - a) <= 1; }
+        };
+
+        auto clusterer = Neuland::ClusteringEngine<int, Condition>();
+        clusterer.SetCellFunction([](const int& a) {
+            return Neuland::ClusteringEngine<int, Condition>::Cell{ { a < 0 ? (a - 1) / 2 : a / 2, 0, 0, 0 } };
+        });
+
+        std::vector<int> digis{ 28, 13, 23, 22, 15, 16, 3, 6, 4, 26, 10, 11, 19, 8, 29, 12, 25, 30, 17, 18, 24 };
+        std::vector<std::vector<int>> clusters = clusterer.Clusterize(digis);
+
+        // Same clusters in the same order as without binning
+        std::vector<std::vector<int>> expected{
+            { 28, 29, 30 }, { 22, 23, 24, 25, 26 }, { 4, 3 }, { 10, 11, 12, 13 }, { 8 }, { 19, 18, 17, 16, 15 }, { 6 }
+        };
+        EXPECT_EQ(clusters, expected);
+    }
+
     TEST(testClusteringEngine, clustering_condition_not_set)
     {
         auto clusterer = Neuland::ClusteringEngine<int>();
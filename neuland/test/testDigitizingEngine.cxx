@@ -0,0 +1,50 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "DigitizingTamex.h"
+#include "gtest/gtest.h"
+
+namespace
+{
+
+    TEST(testDigitizingEngine, paddles_of_one_event)
+    {
+        Neuland::DigitizingTamex engine;
+        engine.DepositLight(12, 10., 100., 0.);
+        engine.DepositLight(3, 11., 100., 20.);
+        engine.DepositLight(12, 12., 50., 0.);
+
+        const auto& paddles = engine.ExtractPaddles();
+        ASSERT_EQ(paddles.size(), 2);
+        EXPECT_EQ(paddles[0].first, 3);
+        EXPECT_EQ(paddles[1].first, 12);
+    }
+
+    TEST(testDigitizingEngine, empty_event_after_event)
+    {
+        Neuland::DigitizingTamex engine;
+        engine.DepositLight(5, 10., 100., 0.);
+        EXPECT_EQ(engine.ExtractPaddles().size(), 1);
+
+        // Second event without any light
+        EXPECT_EQ(engine.GetTriggerTime(), 1e100);
+        EXPECT_TRUE(engine.ExtractPaddles().empty());
+
+        // Third event
+        engine.DepositLight(7, 10., 100., 0.);
+        const auto& paddles = engine.ExtractPaddles();
+        ASSERT_EQ(paddles.size(), 1);
+        EXPECT_EQ(paddles[0].first, 7);
+    }
+
+} // namespace
@@ -0,0 +1,46 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BNeulandMultiplicityBayesPar.h"
+#include "gtest/gtest.h"
+#include <vector>
+
+namespace
+{
+    TEST(testNeulandMultiplicityBayesPar, BatchEqualsSingleEvents)
+    {
+        R3BNeulandMultiplicityBayesPar par;
+        par.Fill(1, 5, 1, 100);
+        par.Fill(1, 6, 2, 120);
+        par.Fill(2, 6, 2, 250);
+        par.Fill(2, 12, 3, 260);
+        par.Fill(3, 12, 4, 400);
+
+        R3BNeulandMultiplicityBayesPar::Features features;
+        features.Add(5, 1, 100);
+        features.Add(6, 2, 125);
+        features.Add(12, 3, 260);
+        features.Add(0, 0, 0);
+
+        std::vector<R3BNeulandMultiplicity::MultiplicityProbabilities> probabilities;
+        par.GetProbabilities(features, probabilities);
+
+        ASSERT_EQ(probabilities.size(), features.Size());
+        for (size_t e = 0; e < features.Size(); e++)
+        {
+            EXPECT_EQ(probabilities[e],
+                      par.GetProbabilities(features.nHits[e], features.nClusters[e], features.Edep[e]));
+        }
+        EXPECT_EQ(probabilities[0][1], 1.);
+    }
+} // namespace
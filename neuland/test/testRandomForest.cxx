@@ -0,0 +1,81 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "RandomForest.h"
+#include "gtest/gtest.h"
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+    // Two trees on two features with classes 1, 2 and 3
+    const char* const model = "R3BRandomForest 1\n"
+                              "2 3 2\n"
+                              "1 2 3\n"
+                              "3\n"
+                              "1 2 0 0.5\n"
+                              "-1 1 0 0\n"
+                              "-1 0 0.25 0.75\n"
+                              "3\n"
+                              "1 2 1 10.5\n"
+                              "-1 0 1 0\n"
+                              "-1 0 0 1\n";
+
+    TEST(testRandomForest, PredictProba)
+    {
+        std::istringstream in(model);
+        Neuland::RandomForest forest;
+        forest.Load(in);
+
+        EXPECT_EQ(forest.GetNFeatures(), 2u);
+        EXPECT_EQ(forest.GetNClasses(), 3u);
+        EXPECT_EQ(forest.GetNTrees(), 2u);
+        EXPECT_EQ(forest.GetClasses(), std::vector<Int_t>({ 1, 2, 3 }));
+
+        std::vector<Double_t> proba;
+        forest.PredictProba({ 0.1, 5., 0.9, 20., 0.5, 10.5 }, proba);
+
+        const std::vector<Double_t> expected{ 0.5, 0.5, 0., 0., 0.125, 0.875, 0.5, 0.5, 0. };
+        ASSERT_EQ(proba.size(), expected.size());
+        for (size_t i = 0; i < expected.size(); i++)
+        {
+            EXPECT_DOUBLE_EQ(proba[i], expected[i]);
+        }
+    }
+
+    TEST(testRandomForest, SinglePrecisionComparison)
+    {
+        // Like scikit-learn, features are rounded to float before comparing them to the threshold
+        std::istringstream in("R3BRandomForest 1\n1 2 1\n0 1\n3\n1 2 0 0.1\n-1 1 0\n-1 0 1\n");
+        Neuland::RandomForest forest;
+        forest.Load(in);
+
+        std::vector<Double_t> proba;
+        forest.PredictProba({ 0.1 }, proba);
+        EXPECT_EQ(proba, std::vector<Double_t>({ 0., 1. }));
+    }
+
+    TEST(testRandomForest, InvalidModel)
+    {
+        Neuland::RandomForest forest;
+        std::istringstream wrongVersion("R3BRandomForest 2\n");
+        EXPECT_THROW(forest.Load(wrongVersion), std::runtime_error);
+        std::istringstream loop("R3BRandomForest 1\n1 2 1\n0 1\n2\n1 0 0 0.5\n-1 1 0\n");
+        EXPECT_THROW(forest.Load(loop), std::runtime_error);
+
+        // Nothing is loaded from invalid models
+        std::vector<Double_t> proba;
+        EXPECT_THROW(forest.PredictProba({ 1. }, proba), std::runtime_error);
+    }
+} // namespace
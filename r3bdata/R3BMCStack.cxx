@@ -42,9 +42,7 @@ R3BStack::R3BStack(Int_t size)
     , fParticles(new TClonesArray("TParticle", size))
     , fTracks(new TClonesArray("R3BMCTrack", size))
     , fStoreMap()
-    , fStoreIter()
     , fIndexMap()
-    , fIndexIter()
     , fPointsMap()
     , fCurrentTrack(-1)
     , fNPrimaries(0)
@@ -244,7 +242,8 @@ void R3BStack::FillTrackArray()
     LOG(DEBUG) << "R3BStack: Filling MCTrack array...";
 
     // --> Reset index map and number of output tracks
-    fIndexMap.clear();
+    // --> Index of primary mothers
+    fIndexMap.assign(fNParticles + 1, -1);
     fNTracks = 0;
 
     //<DB> if no selection than no selection
@@ -268,17 +267,10 @@ void R3BStack::FillTrackArray()
     for (Int_t iPart = 0; iPart < fNParticles; iPart++)
     {
 
-        fStoreIter = fStoreMap.find(iPart);
-        if (fStoreIter == fStoreMap.end())
-        {
-            LOG(FATAL) << "R3BStack: Particle " << iPart << " not found in storage map!";
-        }
-        Bool_t store = (*fStoreIter).second;
-
-        if (store)
+        if (fStoreMap[iPart])
         {
             new ((*fTracks)[fNTracks]) R3BMCTrack(GetParticle(iPart), fPointsMap[iPart], fMC);
-            fIndexMap[iPart] = fNTracks;
+            fIndexMap[iPart + 1] = fNTracks;
             fNTracks++;
             // cout << "-I- TParticle time " << GetParticle(iPart)->T() << endl;
             // cout << "-I- MC Track time " << track->GetStartT() << endl;
@@ -286,13 +278,10 @@ void R3BStack::FillTrackArray()
         else
         {
             LOG(DEBUG) << "R3BMCStack IndexMap ---> -2 for iPart: " << iPart;
-            fIndexMap[iPart] = -2;
+            fIndexMap[iPart + 1] = -2;
         }
     }
 
-    // --> Map index for primary mothers
-    fIndexMap[-1] = -1;
-
     // --> Screen output
     Print(0);
 }
@@ -311,13 +300,7 @@ void R3BStack::UpdateTrackIndex(TRefArray* detList)
     for (Int_t i = 0; i < fNTracks; i++)
     {
         R3BMCTrack* track = (R3BMCTrack*)fTracks->At(i);
-        Int_t iMotherOld = track->GetMotherId();
-        fIndexIter = fIndexMap.find(iMotherOld);
-        if (fIndexIter == fIndexMap.end())
-        {
-            LOG(FATAL) << "R3BStack: Particle index " << iMotherOld << " not found in dex map! ";
-        }
-        track->SetMotherId((*fIndexIter).second);
+        track->SetMotherId(GetTrackIndex(track->GetMotherId()));
     }
 
     // Now iterate through all active detectors
@@ -343,16 +326,12 @@ void R3BStack::UpdateTrackIndex(TRefArray* detList)
 
                 LOG(DEBUG) << "R3BMCStack TrackID Get : " << iTrack;
 
-                fIndexIter = fIndexMap.find(iTrack);
-                if (fIndexIter == fIndexMap.end())
-                {
-                    LOG(FATAL) << "R3BStack: Particle index " << iTrack << " not found in index map! ";
-                }
-                LOG(DEBUG) << "R3BMCStack TrackID Set : " << (*fIndexIter).second;
-                //	if ( ((*fIndexIter).second ) < 0 ) {
+                Int_t iTrackNew = GetTrackIndex(iTrack);
+                LOG(DEBUG) << "R3BMCStack TrackID Set : " << iTrackNew;
+                //	if ( iTrackNew < 0 ) {
                 //	   point->SetTrackID(iTrack);
                 //	}else{
-                point->SetTrackID((*fIndexIter).second);
+                point->SetTrackID(iTrackNew);
                 //	}
             }
         }
@@ -399,13 +378,7 @@ void R3BStack::Print(Int_t iVerbose) const
 // -------------------------------------------------------------------------
 
 // -----   Public method AddPoint (for current track)   --------------------
-void R3BStack::AddPoint(DetectorId detId)
-{
-    if (fPointsMap.find(fCurrentTrack) == fPointsMap.end())
-        fPointsMap[fCurrentTrack][detId] = 1;
-    else
-        fPointsMap[fCurrentTrack][detId]++;
-}
+void R3BStack::AddPoint(DetectorId detId) { AddPoint(detId, fCurrentTrack); }
 // -------------------------------------------------------------------------
 
 // -----   Public method AddPoint (for arbitrary track)  -------------------
@@ -413,10 +386,9 @@ void R3BStack::AddPoint(DetectorId detId, Int_t iTrack)
 {
     if (iTrack < 0)
         return;
-    if (fPointsMap.find(iTrack) == fPointsMap.end())
-        fPointsMap[iTrack][detId] = 1;
-    else
-        fPointsMap[iTrack][detId]++;
+    if (iTrack >= (Int_t)fPointsMap.size())
+        fPointsMap.resize(iTrack + 1); // zero points in all detectors
+    fPointsMap[iTrack][detId]++;
 }
 // -------------------------------------------------------------------------
 
@@ -446,8 +418,10 @@ TParticle* R3BStack::GetParticle(Int_t trackID) const
 void R3BStack::SelectTracks()
 {
 
-    // --> Clear storage map
-    fStoreMap.clear();
+    // --> Clear storage map, tracks without points have zero points
+    fStoreMap.assign(fNParticles, kFALSE);
+    if ((Int_t)fPointsMap.size() < fNParticles)
+        fPointsMap.resize(fNParticles);
 
     // --> Check particles in the fParticle array
     for (Int_t i = 0; i < fNParticles; i++)
@@ -468,10 +442,7 @@ void R3BStack::SelectTracks()
         // --> Calculate number of points
         Int_t nPoints = 0;
         for (Int_t iDet = kREF; iDet < kLAST; iDet++)
-        {
-            if (fPointsMap.find(i) != fPointsMap.end())
-                nPoints += fPointsMap[i][iDet];
-        }
+            nPoints += fPointsMap[i][iDet];
 
         // --> Check for cuts (store primaries in any case)
         if (iMother < 0)
@@ -500,8 +471,9 @@ void R3BStack::SelectTracks()
                 Int_t iMother = GetParticle(i)->GetMother(0);
                 while (iMother >= 0)
                 {
+                    TParticle* mother = GetParticle(iMother);
                     fStoreMap[iMother] = kTRUE;
-                    iMother = GetParticle(iMother)->GetMother(0);
+                    iMother = mother->GetMother(0);
                 }
             }
         }
@@ -509,4 +481,16 @@ void R3BStack::SelectTracks()
 }
 // -------------------------------------------------------------------------
 
+// -----   Private method GetTrackIndex   ----------------------------------
+Int_t R3BStack::GetTrackIndex(Int_t iPart) const
+{
+    if (iPart < -1 || iPart + 1 >= (Int_t)fIndexMap.size())
+    {
+        LOG(FATAL) << "R3BStack: Particle index " << iPart << " not found in index map! ";
+        return -2;
+    }
+    return fIndexMap[iPart + 1];
+}
+// -------------------------------------------------------------------------
+
 ClassImp(R3BStack)
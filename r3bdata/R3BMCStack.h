@@ -48,8 +48,8 @@
 #include "TVirtualMCStack.h"
 
 #include <array>
-#include <map>
 #include <stack>
+#include <vector>
 
 class R3BStack : public FairGenericStack
 {
@@ -220,16 +220,17 @@ class R3BStack : public FairGenericStack
     /** Array of R3BMCTracks containg the tracks written to the output **/
     TClonesArray* fTracks;
 
-    /** STL map from particle index to storage flag  **/
-    std::map<Int_t, Bool_t> fStoreMap;            //!
-    std::map<Int_t, Bool_t>::iterator fStoreIter; //!
+    /** Storage flag of each particle index **/
+    std::vector<Bool_t> fStoreMap; //!
 
-    /** STL map from particle index to track index  **/
-    std::map<Int_t, Int_t> fIndexMap;            //!
-    std::map<Int_t, Int_t>::iterator fIndexIter; //!
+    /** Track index of each particle index, shifted by one:
+     ** fIndexMap[iPart + 1] is the track index of particle iPart,
+     ** fIndexMap[0] = -1 maps the mother of primaries
+     **/
+    std::vector<Int_t> fIndexMap; //!
 
-    /** STL map from track index and detector ID to number of MCPoints **/
-    std::map<int, std::array<int, kLAST + 1>> fPointsMap; //!
+    /** Number of MCPoints of each track index and detector ID **/
+    std::vector<std::array<int, kLAST + 1>> fPointsMap; //!
 
     /** Some indizes and counters **/
     Int_t fCurrentTrack; //! Index of current track
@@ -249,6 +250,9 @@ class R3BStack : public FairGenericStack
     /** Mark tracks for output using selection criteria  **/
     void SelectTracks();
 
+    /** Track index in the output of a particle index, fatal if unknown **/
+    Int_t GetTrackIndex(Int_t iPart) const;
+
     ClassDef(R3BStack, 1)
 };
 
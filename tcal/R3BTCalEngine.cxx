@@ -11,7 +11,10 @@
  * or submit itself to any jurisdiction.                                      *
  ******************************************************************************/
 
+#include <algorithm>
+#include <atomic>
 #include <string>
+#include <thread>
 
 #include "TH1F.h"
 #include "TMath.h"
@@ -20,45 +23,85 @@
 
 #include "R3BTCalEngine.h"
 
-R3BTCalEngine::R3BTCalEngine(R3BTCalPar* param, Int_t minStats)
-    : fMinStats(minStats)
-    , fCal_Par(param)
-    , fClockFreq(0.)
+namespace
 {
-    for (Int_t i = 0; i < N_PLANE_MAX; i++)
+    // Bins of the raw TDC distribution, including under- and overflow.
+    const Int_t c_n_bins = 4097 + 2;
+
+    Int_t ChannelKey(Int_t plane, Int_t paddle, Int_t side)
     {
-        for (Int_t j = 0; j < N_PADDLE_MAX; j++)
-        {
-            for (Int_t k = 0; k < N_SIDE_MAX; k++)
-            {
-                fhData[i][j][k] = NULL;
-                fhTime[i][j][k] = NULL;
-            }
-        }
+        return ((plane - 1) * N_PADDLE_MAX + paddle - 1) * N_SIDE_MAX + side - 1;
+    }
+
+    void ChannelFromKey(Int_t key, Int_t& plane, Int_t& paddle, Int_t& side)
+    {
+        side = key % N_SIDE_MAX + 1;
+        paddle = key / N_SIDE_MAX % N_PADDLE_MAX + 1;
+        plane = key / (N_SIDE_MAX * N_PADDLE_MAX) + 1;
     }
+} // namespace
+
+R3BTCalEngine::Distribution::Distribution()
+    : fBins(c_n_bins, 0)
+    , fEntries(0)
+{
 }
 
-R3BTCalEngine::~R3BTCalEngine()
+void R3BTCalEngine::Distribution::Fill(Int_t tdc)
 {
-    for (Int_t i = 0; i < N_PLANE_MAX; i++)
+    fEntries++;
+    if (tdc < 0)
     {
-        for (Int_t j = 0; j < N_PADDLE_MAX; j++)
-        {
-            for (Int_t k = 0; k < N_SIDE_MAX; k++)
-            {
-                if (fhData[i][j][k])
-                {
-                    delete fhData[i][j][k];
-                }
-                if (fhTime[i][j][k])
-                {
-                    delete fhTime[i][j][k];
-                }
-            }
-        }
+        fBins[0]++;
+    }
+    else if (tdc >= c_n_bins - 2)
+    {
+        fBins[c_n_bins - 1]++;
+    }
+    else
+    {
+        fBins[1 + tdc]++;
+    }
+}
+
+Double_t R3BTCalEngine::Distribution::GetMean() const
+{
+    // Same as TH1::GetMean(): under- and overflow do not enter the statistics.
+    Double_t sumw = 0.;
+    Double_t sumwx = 0.;
+    for (Int_t i = 1; i < c_n_bins - 1; i++)
+    {
+        sumw += fBins[i];
+        sumwx += (Double_t)fBins[i] * (i - 1);
+    }
+    return sumw > 0. ? sumwx / sumw : 0.;
+}
+
+Double_t R3BTCalEngine::Distribution::Integral(Int_t binx1, Int_t binx2) const
+{
+    // Same as TH1::Integral(): the range is clamped to under- and overflow.
+    binx1 = TMath::Max(binx1, 0);
+    binx2 = TMath::Min(binx2, c_n_bins - 1);
+    Double_t sum = 0.;
+    for (Int_t i = binx1; i <= binx2; i++)
+    {
+        sum += fBins[i];
     }
+    return sum;
 }
 
+R3BTCalEngine::R3BTCalEngine(R3BTCalPar* param, Int_t minStats)
+    : fMinStats(minStats)
+    , fData()
+    , fCal_Par(param)
+    , fClockFreq(0.)
+    , fWriteHistograms(kTRUE)
+    , fNofThreads(TMath::Max((Int_t)std::thread::hardware_concurrency(), 1))
+{
+}
+
+R3BTCalEngine::~R3BTCalEngine() {}
+
 void R3BTCalEngine::Fill(Int_t plane, Int_t paddle, Int_t side, Int_t tdc)
 {
     if (plane < 1 || plane > N_PLANE_MAX || paddle < 1 || paddle > N_PADDLE_MAX || side < 1 || side > N_SIDE_MAX)
@@ -67,18 +110,60 @@ void R3BTCalEngine::Fill(Int_t plane, Int_t paddle, Int_t side, Int_t tdc)
         LOG(ERROR) << "R3BTCalEngine::Fill : ranges: " << N_PLANE_MAX << " / " << N_PADDLE_MAX << " / " << N_SIDE_MAX;
         return;
     }
-    if (NULL == fhData[plane - 1][paddle - 1][side - 1])
+    fData[ChannelKey(plane, paddle, side)].Fill(tdc);
+}
+
+std::vector<Int_t> R3BTCalEngine::GetSortedChannels() const
+{
+    std::vector<Int_t> keys;
+    keys.reserve(fData.size());
+    for (const auto& channel : fData)
+    {
+        keys.push_back(channel.first);
+    }
+    std::sort(keys.begin(), keys.end());
+    return keys;
+}
+
+TH1F* R3BTCalEngine::GetDataHistogram(Int_t plane, Int_t paddle, Int_t side) const
+{
+    if (plane < 1 || plane > N_PLANE_MAX || paddle < 1 || paddle > N_PADDLE_MAX || side < 1 || side > N_SIDE_MAX)
+    {
+        return NULL;
+    }
+    auto it = fData.find(ChannelKey(plane, paddle, side));
+    if (fData.end() == it)
     {
-        char strName[255];
-        sprintf(strName, "%s_tcaldata_%d_%d_%d", fCal_Par->GetName(), plane, paddle, side);
-        fhData[plane - 1][paddle - 1][side - 1] = new TH1F(strName, "", 4097, -0.5, 4096.5);
-        sprintf(strName, "%s_time_%d_%d_%d", fCal_Par->GetName(), plane, paddle, side);
-        fhTime[plane - 1][paddle - 1][side - 1] = new TH1F(strName, "", 4097, -0.5, 4096.5);
+        return NULL;
     }
-    fhData[plane - 1][paddle - 1][side - 1]->Fill(tdc);
+    auto h1 = new TH1F(Form("%s_tcaldata_%d_%d_%d", fCal_Par->GetName(), plane, paddle, side), "", 4097, -0.5, 4096.5);
+    for (Int_t i = 0; i < c_n_bins; i++)
+    {
+        h1->SetBinContent(i, it->second.GetBinContent(i));
+    }
+    h1->SetEntries(it->second.GetEntries());
+    return h1;
+}
 
-    //  LOG(INFO) << "R3BTCalEngine:: " << plane << " " << paddle<< " "<<side<<" "<< fhData[plane - 1][paddle - 1][side
-    //  - 1]->GetEntries();
+void R3BTCalEngine::WriteHistograms(Int_t key, const std::vector<Double_t>& time) const
+{
+    if (!fWriteHistograms)
+    {
+        return;
+    }
+    Int_t plane, paddle, side;
+    ChannelFromKey(key, plane, paddle, side);
+
+    TH1F* hData = GetDataHistogram(plane, paddle, side);
+    hData->Write();
+    delete hData;
+
+    TH1F hTime(Form("%s_time_%d_%d_%d", fCal_Par->GetName(), plane, paddle, side), "", 4097, -0.5, 4096.5);
+    for (Int_t i = 0; i < c_n_bins; i++)
+    {
+        hTime.SetBinContent(i, time[i]);
+    }
+    hTime.Write();
 }
 
 void R3BTCalEngine::CalculateParamClockTDC(enum CTDCVariant a_variant)
@@ -95,304 +180,265 @@ void R3BTCalEngine::CalculateParamClockTDC(enum CTDCVariant a_variant)
             assert(0 && "Invalid CTDC variant!");
     }
 
-    for (Int_t i = 0; i < N_PLANE_MAX; i++)
+    Calculate("CalculateParamClockTDC", &R3BTCalEngine::ExtractClockTDC);
+}
+
+void R3BTCalEngine::CalculateParamTacquila()
+{
+    fClockFreq = 1. / TACQUILA_CLOCK_MHZ * 1000.;
+
+    Calculate("CalculateParamTacquila", &R3BTCalEngine::ExtractTacquila);
+}
+
+void R3BTCalEngine::CalculateParamVFTX()
+{
+    fClockFreq = 1. / VFTX_CLOCK_MHZ * 1000.;
+
+    Calculate("CalculateParamVFTX", &R3BTCalEngine::ExtractVFTX);
+}
+
+void R3BTCalEngine::Calculate(const char* method, void (R3BTCalEngine::*extract)(const Distribution&, Params&) const)
+{
+    const std::vector<Int_t> keys = GetSortedChannels();
+    std::vector<const Distribution*> data;
+    data.reserve(keys.size());
+    for (Int_t key : keys)
     {
-        for (Int_t j = 0; j < N_PADDLE_MAX; j++)
+        data.push_back(&fData.at(key));
+    }
+
+    // Every channel is calibrated independently into its own slot, so the
+    // result does not depend on the number of threads.
+    std::vector<Params> params(keys.size());
+    std::atomic<size_t> next(0);
+    auto worker = [&]() {
+        for (size_t i = next++; i < keys.size(); i = next++)
         {
-            for (Int_t k = 0; k < N_SIDE_MAX; k++)
-            {
-                if (NULL == fhData[i][j][k])
-                {
-                    continue;
-                }
-                if (fhData[i][j][k]->GetEntries() < fMinStats)
-                {
-                    continue;
-                }
-
-                // Define range of channels
-                Int_t ic, iMin, iMax;
-                FindRange(fhData[i][j][k], ic, iMin, iMax);
-                if (iMin < 0 || iMax > 4097)
-                {
-                    return;
-                }
-                LOG(INFO) << "R3BTCalEngine::CalculateParamClockTDC() : Range of channels: " << iMin << " - " << iMax;
-
-                Int_t nparam = 0;
-                auto pTCal = new R3BTCalModulePar;
-                pTCal->SetPlane(i + 1);
-                pTCal->SetPaddle(j + 1);
-                pTCal->SetSide(k + 1);
-
-                Double_t total = fhData[i][j][k]->Integral(iMin, iMax);
-                for (Int_t ii = iMin; ii < iMax; ii++)
-                {
-                    auto bin_mid = fhData[i][j][k]->Integral(iMin, ii) + fhData[i][j][k]->GetBinContent(1 + ii) * 0.5;
-                    auto time_ns = bin_mid / total * fClockFreq;
-
-                    fhTime[i][j][k]->SetBinContent(1 + ii, time_ns);
-
-                    pTCal->SetBinLowAt(ii, nparam);
-                    pTCal->SetOffsetAt(time_ns, nparam);
-                    pTCal->IncrementNofChannels();
-                    nparam++;
-                }
-                fCal_Par->AddModulePar(pTCal);
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamClockTDC() : Number of parameters: " << nparam;
-
-                fhData[i][j][k]->Write();
-                fhTime[i][j][k]->Write();
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamClockTDC() : Module: " << (i + 1) << " / " << (j + 1)
-                          << " / " << (k + 1) << " is calibrated."
-
-                    ;
-            }
+            (this->*extract)(*data[i], params[i]);
         }
+    };
+    const Int_t nThreads = TMath::Min((Int_t)keys.size(), fNofThreads);
+    if (nThreads > 1)
+    {
+        std::vector<std::thread> threads;
+        for (Int_t i = 0; i < nThreads; i++)
+        {
+            threads.emplace_back(worker);
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    else
+    {
+        worker();
+    }
+
+    // Store parameters in channel order.
+    for (size_t i = 0; i < keys.size(); i++)
+    {
+        Params& par = params[i];
+        if (!par.enough_stats)
+        {
+            continue;
+        }
+        if (par.iMin < 0 || par.iMax > 4097)
+        {
+            return;
+        }
+        LOG(INFO) << "R3BTCalEngine::" << method << "() : Range of channels: " << par.iMin << " - " << par.iMax;
+
+        Int_t plane, paddle, side;
+        ChannelFromKey(keys[i], plane, paddle, side);
+
+        auto pTCal = new R3BTCalModulePar();
+        pTCal->SetPlane(plane);
+        pTCal->SetPaddle(paddle);
+        pTCal->SetSide(side);
+        const Int_t nparam = par.offset.size();
+        for (Int_t ip = 0; ip < nparam; ip++)
+        {
+            pTCal->SetBinLowAt(par.bin_low[ip], ip);
+            pTCal->SetBinUpAt(par.bin_up[ip], ip);
+            pTCal->SetSlopeAt(par.slope[ip], ip);
+            pTCal->SetOffsetAt(par.offset[ip], ip);
+            pTCal->IncrementNofChannels();
+        }
+        fCal_Par->AddModulePar(pTCal);
+
+        LOG(INFO) << "R3BTCalEngine::" << method << "() : Number of parameters: " << nparam;
+
+        WriteHistograms(keys[i], par.calib);
+        std::vector<Double_t>().swap(par.calib);
+
+        LOG(INFO) << "R3BTCalEngine::" << method << "() : Module: " << plane << " / " << paddle << " / " << side
+                  << " is calibrated.";
     }
 
     fCal_Par->setChanged();
 }
 
-void R3BTCalEngine::CalculateParamTacquila()
+void R3BTCalEngine::Params::Add(Int_t low, Int_t up, Double_t a_slope, Double_t a_offset)
 {
-    fClockFreq = 1. / TACQUILA_CLOCK_MHZ * 1000.;
+    bin_low.push_back(low);
+    bin_up.push_back(up);
+    slope.push_back(a_slope);
+    offset.push_back(a_offset);
+}
+
+Bool_t R3BTCalEngine::PrepareParams(const Distribution& data, Params& par, Int_t& ic) const
+{
+    par.enough_stats = data.GetEntries() >= fMinStats;
+    if (!par.enough_stats)
+    {
+        return kFALSE;
+    }
+
+    // Define range of channels
+    FindRange(data, ic, par.iMin, par.iMax);
+    if (par.iMin < 0 || par.iMax > 4097)
+    {
+        return kFALSE;
+    }
+    if (fWriteHistograms)
+    {
+        par.calib.assign(c_n_bins, 0.);
+    }
+    return kTRUE;
+}
+
+void R3BTCalEngine::ExtractClockTDC(const Distribution& data, Params& par) const
+{
+    Int_t ic;
+    if (!PrepareParams(data, par, ic))
+    {
+        return;
+    }
+    const Int_t iMin = par.iMin;
+    const Int_t iMax = par.iMax;
 
-    for (Int_t i = 0; i < N_PLANE_MAX; i++)
+    Double_t total = data.Integral(iMin, iMax);
+    for (Int_t ii = iMin; ii < iMax; ii++)
     {
-        for (Int_t j = 0; j < N_PADDLE_MAX; j++)
+        auto bin_mid = data.Integral(iMin, ii) + data.GetBinContent(1 + ii) * 0.5;
+        auto time_ns = bin_mid / total * fClockFreq;
+
+        par.SetCalib(1 + ii, time_ns);
+        par.Add(ii, 0, 0., time_ns);
+    }
+}
+
+void R3BTCalEngine::ExtractTacquila(const Distribution& data, Params& par) const
+{
+    Int_t ic;
+    if (!PrepareParams(data, par, ic))
+    {
+        return;
+    }
+    const Int_t iMin = par.iMin;
+    const Int_t iMax = par.iMax;
+
+    Double_t total = data.Integral(iMin, iMax);
+    for (Int_t ii = iMin; ii <= iMax; ii++)
+    {
+        par.SetCalib(ii, data.Integral(iMin, ii) / total * fClockFreq);
+    }
+
+    Int_t il = ic - 10 + 1;
+    Int_t ih = ic;
+    while (il > iMin)
+    {
+        Double_t slope = 0, offset = 0;
+        LinearDown(data, iMin, iMax, il, ih, slope, offset);
+        par.Add(il, ih, slope, offset);
+
+        ih = il;
+        il = ih - 10 + 1;
+    }
+
+    if (ih > iMin)
+    {
+        Double_t slope = 0, offset = 0;
+        Double_t tot = data.Integral(iMin, iMax);
+        Double_t t1 = 0.;
+        Double_t t2 = data.Integral(iMin, ih) / tot * fClockFreq;
+        slope = (t2 - t1) / (Double_t)(ih - iMin);
+        offset = t1;
+        par.Add(iMin, ih, slope, offset);
+    }
+
+    il = ic;
+    ih = ic + 10 - 1;
+    while (ih <= iMax)
+    {
+        Double_t slope = 0, offset = 0;
+        LinearUp(data, iMin, iMax, il, ih, slope, offset);
+        par.Add(il, ih, slope, offset);
+
+        il = ih;
+        if ((iMax - ih) < 100)
+        {
+            ih = il + 5 - 1;
+        }
+        else
         {
-            for (Int_t k = 0; k < N_SIDE_MAX; k++)
-            {
-                if (NULL == fhData[i][j][k])
-                {
-                    continue;
-                }
-                if (fhData[i][j][k]->GetEntries() < fMinStats)
-                {
-                    continue;
-                }
-
-                // Define range of channels
-                Int_t ic, iMin, iMax;
-                FindRange(fhData[i][j][k], ic, iMin, iMax);
-                if (iMin < 0 || iMax > 4097)
-                {
-                    return;
-                }
-                LOG(INFO) << "R3BTCalEngine::CalculateParamTacquila() : Range of channels: " << iMin << " - " << iMax;
-
-                Double_t total = fhData[i][j][k]->Integral(iMin, iMax);
-                for (Int_t ii = iMin; ii <= iMax; ii++)
-                {
-                    fhTime[i][j][k]->SetBinContent(ii, fhData[i][j][k]->Integral(iMin, ii) / total * fClockFreq);
-                }
-
-                Int_t nparam = 0;
-
-                R3BTCalModulePar* pTCal = NULL;
-                pTCal = new R3BTCalModulePar();
-                pTCal->SetPlane(i + 1);
-                pTCal->SetPaddle(j + 1);
-                pTCal->SetSide(k + 1);
-
-                Int_t il = ic - 10 + 1;
-                Int_t ih = ic;
-                while (il > iMin)
-                {
-                    Double_t slope = 0, offset = 0;
-                    LinearDown(fhData[i][j][k], iMin, iMax, il, ih, slope, offset);
-
-                    pTCal->SetBinLowAt(il, nparam);
-                    pTCal->SetBinUpAt(ih, nparam);
-                    pTCal->SetSlopeAt(slope, nparam);
-                    pTCal->SetOffsetAt(offset, nparam);
-                    pTCal->IncrementNofChannels();
-
-                    nparam += 1;
-
-                    ih = il;
-                    il = ih - 10 + 1;
-                }
-
-                if (ih > iMin)
-                {
-                    Double_t slope = 0, offset = 0;
-                    Double_t tot = fhData[i][j][k]->Integral(iMin, iMax);
-                    Double_t t1 = 0.;
-                    Double_t t2 = fhData[i][j][k]->Integral(iMin, ih) / tot * fClockFreq;
-                    slope = (t2 - t1) / (Double_t)(ih - iMin);
-                    offset = t1;
-
-                    pTCal->SetBinLowAt(iMin, nparam);
-                    pTCal->SetBinUpAt(ih, nparam);
-                    pTCal->SetSlopeAt(slope, nparam);
-                    pTCal->SetOffsetAt(offset, nparam);
-                    pTCal->IncrementNofChannels();
-
-                    nparam += 1;
-                }
-
-                il = ic;
-                ih = ic + 10 - 1;
-                while (ih <= iMax)
-                {
-                    Double_t slope = 0, offset = 0;
-                    LinearUp(fhData[i][j][k], iMin, iMax, il, ih, slope, offset);
-
-                    pTCal->SetBinLowAt(il, nparam);
-                    pTCal->SetBinUpAt(ih, nparam);
-                    pTCal->SetSlopeAt(slope, nparam);
-                    pTCal->SetOffsetAt(offset, nparam);
-                    pTCal->IncrementNofChannels();
-
-                    nparam += 1;
-
-                    il = ih;
-                    if ((iMax - ih) < 100)
-                    {
-                        ih = il + 5 - 1;
-                    }
-                    else
-                    {
-                        ih = il + 10 - 1;
-                    }
-                }
-
-                if (il < iMax)
-                {
-                    Double_t slope = 0, offset = 0;
-                    Double_t tot = fhData[i][j][k]->Integral(iMin, iMax);
-                    Double_t t1 = fhData[i][j][k]->Integral(iMin, il) / tot * fClockFreq;
-                    Double_t t2 = fClockFreq;
-                    slope = (t2 - t1) / (Double_t)(iMax - il);
-                    offset = t1;
-
-                    pTCal->SetBinLowAt(il, nparam);
-                    pTCal->SetBinUpAt(iMax, nparam);
-                    pTCal->SetSlopeAt(slope, nparam);
-                    pTCal->SetOffsetAt(offset, nparam);
-                    pTCal->IncrementNofChannels();
-
-                    nparam += 1;
-                }
-
-                fCal_Par->AddModulePar(pTCal);
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamTacquila() : Number of parameters: " << nparam;
-
-                fhData[i][j][k]->Write();
-                fhTime[i][j][k]->Write();
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamTacquila() : Module: " << (i + 1) << " / " << (j + 1)
-                          << " / " << (k + 1) << " is calibrated."
-
-                    ;
-            }
+            ih = il + 10 - 1;
         }
     }
 
-    fCal_Par->setChanged();
+    if (il < iMax)
+    {
+        Double_t slope = 0, offset = 0;
+        Double_t tot = data.Integral(iMin, iMax);
+        Double_t t1 = data.Integral(iMin, il) / tot * fClockFreq;
+        Double_t t2 = fClockFreq;
+        slope = (t2 - t1) / (Double_t)(iMax - il);
+        offset = t1;
+        par.Add(il, iMax, slope, offset);
+    }
 }
 
-void R3BTCalEngine::CalculateParamVFTX()
+void R3BTCalEngine::ExtractVFTX(const Distribution& data, Params& par) const
 {
-    fClockFreq = 1. / VFTX_CLOCK_MHZ * 1000.;
+    Int_t ic;
+    if (!PrepareParams(data, par, ic))
+    {
+        return;
+    }
+    const Int_t iMin = par.iMin;
+    const Int_t iMax = par.iMax;
 
-    for (Int_t i = 0; i < N_PLANE_MAX; i++)
+    Double_t total = data.Integral(iMin, iMax);
+    for (Int_t ii = iMin; ii <= iMax; ii++)
     {
-        //  LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Plane: " << i;
-        for (Int_t j = 0; j < N_PADDLE_MAX; j++)
+        par.SetCalib(ii, data.Integral(iMin, ii) / total * fClockFreq);
+    }
+
+    for (Int_t ibin = iMin; ibin <= iMax; ibin++)
+    {
+        Double_t time = data.Integral(iMin, ibin) / total;
+        if (time > 1.)
         {
-            //	 LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Paddle: " << j;
-
-            for (Int_t k = 0; k < N_SIDE_MAX; k++)
-            {
-
-                // if(i == 0)   LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Detector: "<<i<<", Channel: "<<j<<",
-                // Type: " << k;
-
-                if (NULL == fhData[i][j][k])
-                {
-                    //			LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : NULL: " << fhData[i][j][k];
-                    continue;
-                }
-                if (fhData[i][j][k]->GetEntries() < fMinStats)
-                {
-                    //			LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : fMinStatus: " <<
-                    // fhData[i][j][k]->GetEntries()<<", "<<fMinStats;
-                    continue;
-                }
-
-                // Define range of channels
-                Int_t ic, iMin, iMax;
-                FindRange(fhData[i][j][k], ic, iMin, iMax);
-                if (iMin < 0 || iMax > 4097)
-                {
-                    return;
-                }
-                LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Range of channels: " << iMin << " - " << iMax;
-
-                Double_t total = fhData[i][j][k]->Integral(iMin, iMax);
-                for (Int_t ii = iMin; ii <= iMax; ii++)
-                {
-                    fhTime[i][j][k]->SetBinContent(ii, fhData[i][j][k]->Integral(iMin, ii) / total * fClockFreq);
-                }
-
-                Int_t nparam = 0;
-
-                R3BTCalModulePar* pTCal = NULL;
-                pTCal = new R3BTCalModulePar();
-                pTCal->SetPlane(i + 1);
-                pTCal->SetPaddle(j + 1);
-                pTCal->SetSide(k + 1);
-
-                for (Int_t ibin = iMin; ibin <= iMax; ibin++)
-                {
-                    Double_t time = fhData[i][j][k]->Integral(iMin, ibin) / total;
-                    if (time > 1.)
-                    {
-                        LOG(fatal) << "Integration error.";
-                    }
-                    time *= fClockFreq;
-
-                    pTCal->SetBinLowAt(ibin, nparam);
-                    pTCal->SetOffsetAt(time, nparam);
-                    pTCal->IncrementNofChannels();
-                    nparam += 1;
-                }
-
-                fCal_Par->AddModulePar(pTCal);
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Number of parameters: " << nparam;
-
-                fhData[i][j][k]->Write();
-                fhTime[i][j][k]->Write();
-
-                LOG(INFO) << "R3BTCalEngine::CalculateParamVFTX() : Module: " << (i + 1) << " / " << (j + 1) << " / "
-                          << (k + 1) << " is calibrated."
-
-                    ;
-            }
+            LOG(fatal) << "Integration error.";
         }
+        time *= fClockFreq;
+        par.Add(ibin, 0, 0., time);
     }
-
-    fCal_Par->setChanged();
 }
 
 // iMin == left side of fine times.
 // iMax == right side of fine times.
 // I.e. iMin <= fine-time <= iMax-1.
-void R3BTCalEngine::FindRange(TH1F* h1, Int_t& ic, Int_t& iMin, Int_t& iMax)
+void R3BTCalEngine::FindRange(const Distribution& h1, Int_t& ic, Int_t& iMin, Int_t& iMax) const
 {
-    Double_t mean = h1->GetMean();
+    iMin = iMax = -1;
+    Double_t mean = h1.GetMean();
     ic = (Int_t)(mean + 0.5);
 
     for (Int_t i = 1; i <= 4097; i++)
     {
-        if (h1->GetBinContent(i) > 0)
+        if (h1.GetBinContent(i) > 0)
         {
             iMin = i - 1;
             break;
@@ -401,7 +447,7 @@ void R3BTCalEngine::FindRange(TH1F* h1, Int_t& ic, Int_t& iMin, Int_t& iMax)
 
     for (Int_t i = 4097; i >= 1; i--)
     {
-        if (h1->GetBinContent(i) > 0)
+        if (h1.GetBinContent(i) > 0)
         {
             iMax = i;
             break;
@@ -409,11 +455,17 @@ void R3BTCalEngine::FindRange(TH1F* h1, Int_t& ic, Int_t& iMin, Int_t& iMax)
     }
 }
 
-void R3BTCalEngine::LinearUp(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t& ih, Double_t& slope, Double_t& offset)
+void R3BTCalEngine::LinearUp(const Distribution& h1,
+                             Int_t iMin,
+                             Int_t iMax,
+                             Int_t& il,
+                             Int_t& ih,
+                             Double_t& slope,
+                             Double_t& offset) const
 {
-    Double_t tot = h1->Integral(iMin, iMax);
-    Double_t t1 = h1->Integral(iMin, il) / tot; // * fClockFreq;
-    Double_t t2 = h1->Integral(iMin, ih) / tot; // * fClockFreq;
+    Double_t tot = h1.Integral(iMin, iMax);
+    Double_t t1 = h1.Integral(iMin, il) / tot; // * fClockFreq;
+    Double_t t2 = h1.Integral(iMin, ih) / tot; // * fClockFreq;
     if (t1 > 1. || t2 > 1.)
     {
         LOG(fatal) << "LinearUp: Integration error";
@@ -423,7 +475,7 @@ void R3BTCalEngine::LinearUp(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t&
     slope = (t2 - t1) / (Double_t)(ih - il);
     offset = t1;
 
-    Double_t prec = 3. / TMath::Sqrt(h1->GetEntries());
+    Double_t prec = 3. / TMath::Sqrt(h1.GetEntries());
 
     Double_t slope1;
 
@@ -435,7 +487,7 @@ void R3BTCalEngine::LinearUp(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t&
         {
             break;
         }
-        Double_t t21 = h1->Integral(iMin, ih_next) / tot * fClockFreq;
+        Double_t t21 = h1.Integral(iMin, ih_next) / tot * fClockFreq;
         slope1 = (t21 - t1) / (Double_t)(ih_next - il);
 
         Double_t dev = TMath::Abs(slope1 - slope) / TMath::Abs(slope);
@@ -451,21 +503,21 @@ void R3BTCalEngine::LinearUp(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t&
     }
 }
 
-void R3BTCalEngine::LinearDown(TH1F* h1,
+void R3BTCalEngine::LinearDown(const Distribution& h1,
                                Int_t iMin,
                                Int_t iMax,
                                Int_t& il,
                                Int_t& ih,
                                Double_t& slope,
-                               Double_t& offset)
+                               Double_t& offset) const
 {
-    Double_t tot = h1->Integral(iMin, iMax);
-    Double_t t1 = h1->Integral(iMin, il) / tot * fClockFreq;
-    Double_t t2 = h1->Integral(iMin, ih) / tot * fClockFreq;
+    Double_t tot = h1.Integral(iMin, iMax);
+    Double_t t1 = h1.Integral(iMin, il) / tot * fClockFreq;
+    Double_t t2 = h1.Integral(iMin, ih) / tot * fClockFreq;
     slope = (t2 - t1) / (Double_t)(ih - il);
     offset = t1;
 
-    Double_t prec = 3. / TMath::Sqrt(h1->GetEntries());
+    Double_t prec = 3. / TMath::Sqrt(h1.GetEntries());
 
     Double_t slope1;
     Double_t offset1;
@@ -478,8 +530,8 @@ void R3BTCalEngine::LinearDown(TH1F* h1,
         {
             break;
         }
-        Double_t t11 = h1->Integral(iMin, il_next) / tot * fClockFreq;
-        Double_t t21 = h1->Integral(iMin, ih_next) / tot * fClockFreq;
+        Double_t t11 = h1.Integral(iMin, il_next) / tot * fClockFreq;
+        Double_t t21 = h1.Integral(iMin, ih_next) / tot * fClockFreq;
         slope1 = (t21 - t11) / (Double_t)(ih_next - il_next);
         offset1 = t11;
 
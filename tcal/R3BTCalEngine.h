@@ -26,6 +26,9 @@
 #include "R3BTCalPar.h"
 #include "TObject.h"
 
+#include <unordered_map>
+#include <vector>
+
 class TH1F;
 
 /**
@@ -35,6 +38,9 @@ class TH1F;
  * clock cycle in ns is calculated from it.
  * Recommended value of minimum statistics per module is
  * 10000 entries.
+ * Raw TDC distributions are kept as plain integer counters only for
+ * channels which actually received data. ROOT histograms are created
+ * on demand for QA.
  * @author D. Kresan
  * @since September 4, 2015
  */
@@ -100,20 +106,94 @@ class R3BTCalEngine : public TObject
      */
     void CalculateParamVFTX();
 
+    /**
+     * A method to enable or disable writing of the raw TDC distribution and
+     * of the bin-by-bin calibration of every calibrated module to the
+     * current directory. Enabled by default.
+     * @param write kTRUE to write the histograms.
+     */
+    void SetWriteHistograms(Bool_t write) { fWriteHistograms = write; }
+
+    /**
+     * A method to create a ROOT histogram of the raw TDC distribution
+     * of a specific module for QA. The caller takes ownership.
+     * @return a new histogram or NULL if the module has no data.
+     */
+    TH1F* GetDataHistogram(Int_t plane, Int_t paddle, Int_t side) const;
+
+    /**
+     * A method to set the number of threads used to calculate parameters.
+     * Channels are calibrated independently and stored in a fixed order, so
+     * the result does not depend on this number. Defaults to the number of cores.
+     * @param nThreads a number of threads, 1 for serial processing.
+     */
+    void SetNofThreads(Int_t nThreads) { fNofThreads = nThreads; }
+
   protected:
+    /**
+     * Raw TDC distribution of one channel. Binning follows a TH1F with 4097 bins
+     * from -0.5 to 4096.5: bin 0 is underflow, bin 1 + tdc holds TDC value tdc
+     * and bin 4098 is overflow.
+     */
+    class Distribution
+    {
+      public:
+        Distribution();
+        void Fill(Int_t tdc);
+        Double_t GetEntries() const { return fEntries; }
+        Double_t GetBinContent(Int_t bin) const { return fBins[bin]; }
+        Double_t GetMean() const;
+        Double_t Integral(Int_t binx1, Int_t binx2) const;
+
+      private:
+        std::vector<UInt_t> fBins; /**< Counts per bin, including under- and overflow. */
+        UInt_t fEntries;           /**< Number of calls to Fill(). */
+    };
+
+    /**
+     * Calibration parameters of one channel, filled by the Extract*() methods
+     * and stored to the parameter container afterwards.
+     */
+    struct Params
+    {
+        Params()
+            : enough_stats(kFALSE)
+            , iMin(-1)
+            , iMax(-1)
+        {
+        }
+        void Add(Int_t low, Int_t up, Double_t a_slope, Double_t a_offset);
+        void SetCalib(Int_t bin, Double_t time)
+        {
+            if (!calib.empty())
+            {
+                calib[bin] = time;
+            }
+        }
+
+        Bool_t enough_stats;          /**< Channel has at least the minimum statistics. */
+        Int_t iMin;                   /**< Lower bound of the TDC range. */
+        Int_t iMax;                   /**< Upper bound of the TDC range. */
+        std::vector<Int_t> bin_low;   /**< Lower TDC range of a linear segment. */
+        std::vector<Int_t> bin_up;    /**< Upper TDC range of a linear segment. */
+        std::vector<Double_t> slope;  /**< Slope of linear interpolation. */
+        std::vector<Double_t> offset; /**< Offset of linear interpolation [ns]. */
+        std::vector<Double_t> calib;  /**< Bin-by-bin calibration for QA by histogram bin, empty if not written. */
+    };
+
     /**
      * A method to determine the range of a TDC distribution.
-     * @param h1 a pointer to the histogram with data.
+     * @param h1 the distribution with data.
      * @param ic output: center of distribution.
      * @param iMin output: lower bound.
      * @param iMax output: upper bound.
      */
-    void FindRange(TH1F* h1, Int_t& ic, Int_t& iMin, Int_t& iMax);
+    void FindRange(const Distribution& h1, Int_t& ic, Int_t& iMin, Int_t& iMax) const;
 
     /**
      * A method to interpolate a section of the raw TDC distribution
      * starting from the middle towards the lower bound.
-     * @param h1 a pointer to the histogram with data.
+     * @param h1 the distribution with data.
      * @param iMin a lower bound.
      * @param iMax an upper bound.
      * @param il an initial value and output of a lower bound of the section.
@@ -121,12 +201,18 @@ class R3BTCalEngine : public TObject
      * @param slope output: a slope of linear interpolation.
      * @param offset output: an offset of linear interpolation (value at il).
      */
-    void LinearUp(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t& ih, Double_t& slope, Double_t& offset);
+    void LinearUp(const Distribution& h1,
+                  Int_t iMin,
+                  Int_t iMax,
+                  Int_t& il,
+                  Int_t& ih,
+                  Double_t& slope,
+                  Double_t& offset) const;
 
     /**
      * A method to interpolate a section of the raw TDC distribution
      * starting from the middle towards the upper bound.
-     * @param h1 a pointer to the histogram with data.
+     * @param h1 the distribution with data.
      * @param iMin a lower bound.
      * @param iMax an upper bound.
      * @param il an initial value and output of a lower bound of the section.
@@ -134,18 +220,56 @@ class R3BTCalEngine : public TObject
      * @param slope output: a slope of linear interpolation.
      * @param offset output: an offset of linear interpolation (value at il).
      */
-    void LinearDown(TH1F* h1, Int_t iMin, Int_t iMax, Int_t& il, Int_t& ih, Double_t& slope, Double_t& offset);
+    void LinearDown(const Distribution& h1,
+                    Int_t iMin,
+                    Int_t iMax,
+                    Int_t& il,
+                    Int_t& ih,
+                    Double_t& slope,
+                    Double_t& offset) const;
 
   private:
+    /**
+     * A method to calculate parameters of all channels with data on fNofThreads
+     * threads and to store them in the parameter container in channel order.
+     * @param method name of the calling method for log messages.
+     * @param extract a method to calculate parameters of a single channel.
+     */
+    void Calculate(const char* method, void (R3BTCalEngine::*extract)(const Distribution&, Params&) const);
+
+    /**
+     * A method to check the statistics and to find the range of a channel.
+     * @return kTRUE if the channel can be calibrated.
+     */
+    Bool_t PrepareParams(const Distribution& data, Params& par, Int_t& ic) const;
+
+    /** Methods to calculate parameters of a single channel. Safe to call concurrently. */
+    void ExtractClockTDC(const Distribution& data, Params& par) const;
+    void ExtractTacquila(const Distribution& data, Params& par) const;
+    void ExtractVFTX(const Distribution& data, Params& par) const;
+
+    /**
+     * A method to get the keys of all channels with data, sorted by plane, paddle and side.
+     */
+    std::vector<Int_t> GetSortedChannels() const;
+
+    /**
+     * A method to write the raw TDC distribution and the bin-by-bin calibration
+     * of a module, if enabled.
+     * @param key a channel key.
+     * @param time bin-by-bin calibration, indexed by histogram bin.
+     */
+    void WriteHistograms(Int_t key, const std::vector<Double_t>& time) const;
+
     Int_t fMinStats; /**< Minimum number of entries in raw TDC distribution per module */
-    TH1F* fhData[N_PLANE_MAX][N_PADDLE_MAX][N_SIDE_MAX]; /**< An array of histograms to store raw TDC distributions. */
-    TH1F* fhTime[N_PLANE_MAX][N_PADDLE_MAX]
-                [N_SIDE_MAX]; /**< An array of histograms to store unparametrized bin-by-bin calibration. */
+    std::unordered_map<Int_t, Distribution> fData; //! Raw TDC distributions of channels with data, by channel key.
     R3BTCalPar* fCal_Par;     /**< A pointer to the parameter container. */
     Double_t fClockFreq;      /**< A clock cycle in [ns]. */
+    Bool_t fWriteHistograms;  /**< Write QA histograms of calibrated modules. */
+    Int_t fNofThreads;        /**< Number of threads for parameter calculation. */
 
   public:
-    ClassDef(R3BTCalEngine, 1)
+    ClassDef(R3BTCalEngine, 2)
 };
 
 #endif
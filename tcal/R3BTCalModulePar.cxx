@@ -18,6 +18,7 @@
 
 #include "TF1.h"
 #include "TH1F.h"
+#include "TMath.h"
 #include "TPad.h"
 
 using namespace std;
@@ -92,6 +93,7 @@ Bool_t R3BTCalModulePar::getParams(FairParamList* list)
     {
         return kFALSE;
     }
+    ResetTables();
 
     return kTRUE;
 }
@@ -106,6 +108,7 @@ void R3BTCalModulePar::clear()
         fSlope[i] = 0.;
         fOffset[i] = 0.;
     }
+    ResetTables();
 }
 
 void R3BTCalModulePar::printParams()
@@ -125,39 +128,91 @@ void R3BTCalModulePar::printParams()
 
 Double_t R3BTCalModulePar::GetTimeClockTDC(Int_t tdc)
 {
-    for (Int_t i = 0; i < fNofChannels; i++)
+    if (fBinTable.empty())
     {
-        if (tdc == fBinLow[i])
-        {
-            Double_t time = fOffset[i];
-            return time;
-        }
+        CompileBinTable();
     }
-    return -10000.;
+    if (tdc >= 0 && tdc < NTDCBINS)
+    {
+        return fBinTable[tdc];
+    }
+    return ScanBin(tdc);
 }
 
 Double_t R3BTCalModulePar::GetTimeTacquila(Int_t tdc)
 {
     tdc = tdc + 1;
+    if (fSegmentTable.empty())
+    {
+        CompileSegmentTable();
+    }
+    if (tdc >= 0 && tdc < NTDCBINS)
+    {
+        return fSegmentTable[tdc];
+    }
+    return ScanSegment(tdc);
+}
+
+Double_t R3BTCalModulePar::GetTimeVFTX(Int_t tdc)
+{
+    if (fBinTable.empty())
+    {
+        CompileBinTable();
+    }
+    if (tdc + 1 >= 0 && tdc + 1 < NTDCBINS)
+    {
+        return fBinTable[tdc + 1];
+    }
+    return ScanBin(tdc + 1);
+}
+
+void R3BTCalModulePar::CompileBinTable()
+{
+    fBinTable.assign(NTDCBINS, -10000.);
+    // Walk backwards, so the first matching parameter wins as in ScanBin().
+    for (Int_t i = fNofChannels - 1; i >= 0; i--)
+    {
+        if (fBinLow[i] >= 0 && fBinLow[i] < NTDCBINS)
+        {
+            fBinTable[fBinLow[i]] = fOffset[i];
+        }
+    }
+}
+
+void R3BTCalModulePar::CompileSegmentTable()
+{
+    fSegmentTable.assign(NTDCBINS, -10000.);
+    // Walk backwards, so the first matching segment wins as in ScanSegment().
+    for (Int_t i = fNofChannels - 1; i >= 0; i--)
+    {
+        const Int_t low = TMath::Max(fBinLow[i], 0);
+        const Int_t up = TMath::Min(fBinUp[i], NTDCBINS - 1);
+        for (Int_t bin = low; bin <= up; bin++)
+        {
+            fSegmentTable[bin] = fOffset[i] + fSlope[i] * (Double_t)(bin - fBinLow[i]);
+        }
+    }
+}
+
+Double_t R3BTCalModulePar::ScanBin(Int_t bin) const
+{
     for (Int_t i = 0; i < fNofChannels; i++)
     {
-        if (tdc >= fBinLow[i] && tdc <= fBinUp[i])
+        if (bin == fBinLow[i])
         {
-            Double_t time = fOffset[i] + fSlope[i] * (Double_t)(tdc - fBinLow[i]);
-            return time;
+            return fOffset[i];
         }
     }
     return -10000.;
 }
 
-Double_t R3BTCalModulePar::GetTimeVFTX(Int_t tdc)
+Double_t R3BTCalModulePar::ScanSegment(Int_t bin) const
 {
     for (Int_t i = 0; i < fNofChannels; i++)
     {
-        if ((tdc + 1) == fBinLow[i])
+        if (bin >= fBinLow[i] && bin <= fBinUp[i])
         {
-            Double_t time = fOffset[i];
-            return time;
+            return fOffset[i] + fSlope[i] * (Double_t)(bin - fBinLow[i]);
         }
     }
     return -10000.;
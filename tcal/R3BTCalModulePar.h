@@ -16,7 +16,10 @@
 
 #include "FairParGenericSet.h"
 
+#include <vector>
+
 #define NCHMAX 5000
+#define NTDCBINS 4098 // TDC bins 0 .. 4097, covers the 4097-bin raw distributions of R3BTCalEngine
 
 class FairParamList;
 
@@ -25,6 +28,8 @@ class FairParamList;
  * storage of time calibration parameters for a detector module. It contains
  * parametrisation of a table, used for TDC -> time [ns] conversion. Currently
  * supported systems: TACQUILA and VFTX.
+ * On first use the parametrisation is compiled into a dense lookup table indexed
+ * by TDC bin, so the conversion does not scan the parameter arrays per hit.
  * @author D. Kresan
  * @since September 2, 2015
  */
@@ -103,6 +108,16 @@ class R3BTCalModulePar : public FairParGenericSet
      */
     Double_t GetTimeVFTX(Int_t tdc);
 
+    /**
+     * Drops the compiled lookup tables. They are rebuilt on the next
+     * call of GetTime*(). Called whenever the parameters change.
+     */
+    void ResetTables()
+    {
+        fBinTable.clear();
+        fSegmentTable.clear();
+    }
+
     /** Accessor functions **/
     Int_t GetPlane() const { return fPlane; }
     Int_t GetPaddle() const { return fPaddle; }
@@ -115,13 +130,50 @@ class R3BTCalModulePar : public FairParGenericSet
     void SetPlane(Int_t i) { fPlane = i; }
     void SetPaddle(Int_t i) { fPaddle = i; }
     void SetSide(Int_t i) { fSide = i; }
-    void IncrementNofChannels() { fNofChannels += 1; }
-    void SetBinLowAt(Int_t ch, Int_t i) { fBinLow[i] = ch; }
-    void SetBinUpAt(Int_t ch, Int_t i) { fBinUp[i] = ch; }
-    void SetSlopeAt(Double_t slope, Int_t i) { fSlope[i] = slope; }
-    void SetOffsetAt(Double_t offset, Int_t i) { fOffset[i] = offset; }
+    void IncrementNofChannels()
+    {
+        fNofChannels += 1;
+        ResetTables();
+    }
+    void SetBinLowAt(Int_t ch, Int_t i)
+    {
+        fBinLow[i] = ch;
+        ResetTables();
+    }
+    void SetBinUpAt(Int_t ch, Int_t i)
+    {
+        fBinUp[i] = ch;
+        ResetTables();
+    }
+    void SetSlopeAt(Double_t slope, Int_t i)
+    {
+        fSlope[i] = slope;
+        ResetTables();
+    }
+    void SetOffsetAt(Double_t offset, Int_t i)
+    {
+        fOffset[i] = offset;
+        ResetTables();
+    }
 
   private:
+    /**
+     * Builds the lookup table for electronics with one parameter per TDC bin
+     * (VFTX and clock TDC). Entry b holds the offset of the first parameter
+     * with fBinLow == b, or -10000 if there is none.
+     */
+    void CompileBinTable();
+
+    /**
+     * Builds the lookup table for electronics with piecewise-linear
+     * parametrisation (TACQUILA). Entry b holds the time of the first
+     * segment with fBinLow <= b <= fBinUp, or -10000 if there is none.
+     */
+    void CompileSegmentTable();
+
+    Double_t ScanBin(Int_t bin) const;
+    Double_t ScanSegment(Int_t bin) const;
+
     Int_t fPlane;             /**< Index of a plane. */
     Int_t fPaddle;            /**< Index of a paddle. */
     Int_t fSide;              /**< Side of a module: for NeuLAND - L/R PMT. */
@@ -131,6 +183,9 @@ class R3BTCalModulePar : public FairParGenericSet
     Double_t fSlope[NCHMAX];  /**< Slope of liear interpolation. */
     Double_t fOffset[NCHMAX]; /**< Offset of linear interpolation [ns]. */
 
+    std::vector<Double_t> fBinTable;     //! Compiled TDC bin -> time [ns] for VFTX and clock TDC.
+    std::vector<Double_t> fSegmentTable; //! Compiled TDC bin -> time [ns] for TACQUILA.
+
     ClassDef(R3BTCalModulePar, 1);
 };
 
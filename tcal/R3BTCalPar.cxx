@@ -23,6 +23,9 @@ R3BTCalPar::R3BTCalPar(const char* name, const char* title, const char* context,
     : FairParGenericSet(name, title, context, own)
     , fTCalParams(new TObjArray(NMODULEMAX))
     , fMapInit(kFALSE)
+    , fNofPlanes(0)
+    , fNofPaddles(0)
+    , fNofSides(0)
 {
 }
 
@@ -55,10 +58,24 @@ Bool_t R3BTCalPar::getParams(FairParamList* list)
     {
         return kFALSE;
     }
+    for (Int_t i = 0; i < fTCalParams->GetEntriesFast(); i++)
+    {
+        R3BTCalModulePar* par = (R3BTCalModulePar*)fTCalParams->At(i);
+        if (par)
+        {
+            par->ResetTables();
+        }
+    }
+    fMapInit = kFALSE;
     return kTRUE;
 }
 
-void R3BTCalPar::clear() {}
+void R3BTCalPar::clear()
+{
+    // The index points into fTCalParams, which is refilled by the next read
+    fMapInit = kFALSE;
+    fIndex.clear();
+}
 
 void R3BTCalPar::printParams()
 {
@@ -77,61 +94,80 @@ void R3BTCalPar::printParams()
     }
 }
 
-R3BTCalModulePar* R3BTCalPar::GetModuleParAt(Int_t plane, Int_t paddle, Int_t side)
+void R3BTCalPar::BuildIndex()
 {
-    if (!fMapInit)
+    fNofPlanes = fNofPaddles = fNofSides = 0;
+    R3BTCalModulePar* par;
+    Int_t tplane;
+    Int_t tpaddle;
+    Int_t tside;
+    for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
     {
-        fIndexMap.clear();
-        R3BTCalModulePar* par;
-        Int_t tplane;
-        Int_t tpaddle;
-        Int_t tside;
-        Int_t index;
-        for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
+        par = (R3BTCalModulePar*)fTCalParams->At(i);
+        if (NULL == par)
         {
-            par = (R3BTCalModulePar*)fTCalParams->At(i);
-            if (NULL == par)
-            {
-                continue;
-            }
-            tplane = par->GetPlane();
-            tpaddle = par->GetPaddle();
-            tside = par->GetSide();
-            if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
-                tside > N_SIDE_MAX)
-            {
-                LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << tplane << " / "
-                           << tpaddle << " / " << tside;
-                continue;
-            }
-            index = (tplane - 1) * N_PADDLE_MAX * N_SIDE_MAX + (tpaddle - 1) * N_SIDE_MAX + tside - 1;
-            if (fIndexMap.find(index) != fIndexMap.end())
-            {
-                LOG(ERROR) << "R3BTCalPar::GetModuleParAt : parameter found more than once. " << tplane << " / "
-                           << tpaddle << " / " << tside;
-                continue;
-            }
-            fIndexMap[index] = i;
+            continue;
         }
-        fMapInit = kTRUE;
+        tplane = par->GetPlane();
+        tpaddle = par->GetPaddle();
+        tside = par->GetSide();
+        if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
+            tside > N_SIDE_MAX)
+        {
+            continue;
+        }
+        fNofPlanes = TMath::Max(fNofPlanes, tplane);
+        fNofPaddles = TMath::Max(fNofPaddles, tpaddle);
+        fNofSides = TMath::Max(fNofSides, tside);
+    }
+
+    fIndex.assign(fNofPlanes * fNofPaddles * fNofSides, NULL);
+    Int_t index;
+    for (Int_t i = 0; i < fTCalParams->GetEntries(); i++)
+    {
+        par = (R3BTCalModulePar*)fTCalParams->At(i);
+        if (NULL == par)
+        {
+            continue;
+        }
+        tplane = par->GetPlane();
+        tpaddle = par->GetPaddle();
+        tside = par->GetSide();
+        if (tplane < 1 || tplane > N_PLANE_MAX || tpaddle < 1 || tpaddle > N_PADDLE_MAX || tside < 1 ||
+            tside > N_SIDE_MAX)
+        {
+            LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << tplane << " / "
+                       << tpaddle << " / " << tside;
+            continue;
+        }
+        index = ((tplane - 1) * fNofPaddles + tpaddle - 1) * fNofSides + tside - 1;
+        if (NULL != fIndex[index])
+        {
+            LOG(ERROR) << "R3BTCalPar::GetModuleParAt : parameter found more than once. " << tplane << " / "
+                       << tpaddle << " / " << tside;
+            continue;
+        }
+        fIndex[index] = par;
     }
+    fMapInit = kTRUE;
+}
 
+R3BTCalModulePar* R3BTCalPar::GetModuleParAt(Int_t plane, Int_t paddle, Int_t side)
+{
     if (plane < 1 || plane > N_PLANE_MAX || paddle < 1 || paddle > N_PADDLE_MAX || side < 1 || side > N_SIDE_MAX)
     {
         LOG(ERROR) << "R3BTCalPar::GetModuleParAt : error in plane/paddle/side indexing. " << plane << " / " << paddle
                    << " / " << side;
         return NULL;
     }
-    Int_t index = (plane - 1) * N_PADDLE_MAX * N_SIDE_MAX + (paddle - 1) * N_SIDE_MAX + side - 1;
 
-    if (fIndexMap.find(index) == fIndexMap.end())
+    R3BTCalModulePar* par = FindModulePar(plane, paddle, side);
+    if (NULL == par)
     {
         LOG(WARNING) << "R3BTCalPar::GetModuleParAt : parameter not found for: " << plane << " / " << paddle << " / "
                      << side;
-        return NULL;
     }
-    Int_t arind = fIndexMap[index];
-    return (R3BTCalModulePar*)fTCalParams->At(arind);
+    return par;
 }
 
 void R3BTCalPar::AddModulePar(R3BTCalModulePar* tch)
@@ -22,8 +22,11 @@
 
 #include "FairParGenericSet.h" // for FairParGenericSet
 #include "R3BTCalModulePar.h"
+#include "TClonesArray.h"
+#include "TMath.h"
 #include "TObjArray.h"
 #include <map>
+#include <vector>
 
 using namespace std;
 
@@ -35,6 +38,8 @@ class FairParamList;
  * module (of type R3BTCalModulePar). Instance of this class has to be
  * created using FairRuntimeDB::getContainer("name") method. Supported
  * names: LandTCalPar, LosTCalPar.
+ * Module containers are looked up through a flat index over the
+ * plane/paddle/side extents of the loaded parameters.
  * @author D. Kresan
  * @since September 3, 2015
  */
@@ -145,16 +150,93 @@ class R3BTCalPar : public FairParGenericSet
      */
     R3BTCalModulePar* GetModuleParAt(Int_t plane, Int_t paddle, Int_t side);
 
+    /**
+     * Method to get single parameter container for a specific module without
+     * any diagnostics. To be used in loops where missing modules are expected.
+     * @return parameter container of this module or NULL if not found.
+     */
+    R3BTCalModulePar* FindModulePar(Int_t plane, Int_t paddle, Int_t side)
+    {
+        if (!fMapInit)
+        {
+            BuildIndex();
+        }
+        if (plane < 1 || plane > fNofPlanes || paddle < 1 || paddle > fNofPaddles || side < 1 || side > fNofSides)
+        {
+            return NULL;
+        }
+        return fIndex[((plane - 1) * fNofPaddles + paddle - 1) * fNofSides + side - 1];
+    }
+
+    /**
+     * Address of a hit in a mapped data array, as returned by the accessor
+     * passed to Calibrate().
+     */
+    struct Channel
+    {
+        Channel(Int_t a_plane, Int_t a_paddle, Int_t a_side, Int_t a_tdc)
+            : plane(a_plane)
+            , paddle(a_paddle)
+            , side(a_side)
+            , tdc(a_tdc)
+        {
+        }
+        Int_t plane;
+        Int_t paddle;
+        Int_t side;
+        Int_t tdc;
+    };
+
+    /**
+     * Method to calibrate the fine times of all hits in a mapped data array in one call.
+     * @param mapped an array with mapped data objects of type T.
+     * @param channel a callable returning the R3BTCalPar::Channel of a const T*.
+     * @param getTime conversion to use, e.g. &R3BTCalModulePar::GetTimeVFTX.
+     * @param times output: a time [ns] per entry of mapped, NaN if no parameters were found.
+     * @return number of calibrated hits.
+     */
+    template <typename T, typename F>
+    Int_t Calibrate(const TClonesArray* mapped,
+                    F channel,
+                    Double_t (R3BTCalModulePar::*getTime)(Int_t),
+                    std::vector<Double_t>& times)
+    {
+        const Int_t n = mapped->GetEntriesFast();
+        times.resize(n);
+        Int_t nCalibrated = 0;
+        for (Int_t i = 0; i < n; i++)
+        {
+            const Channel ch = channel(static_cast<const T*>(mapped->UncheckedAt(i)));
+            R3BTCalModulePar* par = FindModulePar(ch.plane, ch.paddle, ch.side);
+            if (NULL == par)
+            {
+                times[i] = TMath::QuietNaN();
+                continue;
+            }
+            times[i] = (par->*getTime)(ch.tdc);
+            nCalibrated++;
+        }
+        return nCalibrated;
+    }
+
   private:
+    /**
+     * Method to fill the flat index from the array of module containers.
+     */
+    void BuildIndex();
+
     const R3BTCalPar& operator=(const R3BTCalPar&); /**< an assignment operator */
     R3BTCalPar(const R3BTCalPar&);                  /**< a copy constructor */
 
     TObjArray* fTCalParams; /**< an array with parameter containers of all modules */
 
-    Bool_t fMapInit;             /**< a boolean flag for indication whether the indexing map is initialized */
-    map<Int_t, Int_t> fIndexMap; /**< a map between index of a container in array and plane,paddle,side */
+    Bool_t fMapInit;                        //! a boolean flag for indication whether the index is initialized
+    Int_t fNofPlanes;                       //! extent of the index in planes
+    Int_t fNofPaddles;                      //! extent of the index in paddles
+    Int_t fNofSides;                        //! extent of the index in sides
+    std::vector<R3BTCalModulePar*> fIndex; //! module containers by (plane - 1, paddle - 1, side - 1)
 
-    ClassDef(R3BTCalPar, 1);
+    ClassDef(R3BTCalPar, 2);
 };
 
 #endif /* !R3BTCALPAR_H*/
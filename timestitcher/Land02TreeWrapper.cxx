@@ -39,11 +39,17 @@ namespace R3BCalifaTimestitcher
         if (branchmap.count("Pspx05n") == 0)
             throw runtime_error("Land02TreeWrapper: Could not find branch Pspx05n!");
         pspx05n = static_cast<uint32_t*>(branchmap["Pspx05n"]);
+
+        // Enough to decide about an entry
+        addSelectionBranch("Wr_time_l");
+        addSelectionBranch("Wr_time_h");
+        addSelectionBranch("Pspx04n");
+        addSelectionBranch("Pspx05n");
     }
 
-    uint64_t Land02TreeWrapper::getTS()
+    uint64_t Land02TreeWrapper::computeTS()
     {
-        //      cerr << "Land02TreeWrapper::getTS()" << endl;
+        //      cerr << "Land02TreeWrapper::computeTS()" << endl;
         uint64_t ts = (uint64_t)*TSLow | ((uint64_t)*TSHigh << 32);
         //      cerr << "-> " << ts << endl;
         return ts;
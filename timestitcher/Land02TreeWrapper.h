@@ -22,7 +22,7 @@ namespace R3BCalifaTimestitcher
     class Land02TreeWrapper : public TreeWrapper
     {
       protected:
-        virtual uint64_t getTS();
+        virtual uint64_t computeTS();
         virtual bool isGood();
 
         uint32_t* TSLow;
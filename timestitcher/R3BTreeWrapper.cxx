@@ -38,26 +38,29 @@ namespace R3BCalifaTimestitcher
         {
             ptrObjArr = static_cast<TObjArray*>(branchmap["CalifaMappedData"]);
             type = CalifaMappedData;
+            addSelectionBranch("CalifaMappedData");
         }
         // ...R3BCalifaCrystalCalData
         else if (branchmap.count("CalifaCrystalCalData") > 0)
         {
             ptrObjArr = static_cast<TObjArray*>(branchmap["CalifaCrystalCalData"]);
             type = CalifaCrystalCalData;
+            addSelectionBranch("CalifaCrystalCalData");
         }
         // ...R3BCalifaHitData
         else if (branchmap.count("CalifaHitData") > 0)
         {
             ptrObjArr = static_cast<TObjArray*>(branchmap["CalifaHitData"]);
             type = CalifaHitData;
+            addSelectionBranch("CalifaHitData");
         }
         else
             throw runtime_error("R3BTreeWrapper: Unknown tree structure!");
     }
 
-    uint64_t R3BTreeWrapper::getTS()
+    uint64_t R3BTreeWrapper::computeTS()
     {
-        //      cerr << "R3BTreeWrapper::getTS()" << endl;
+        //      cerr << "R3BTreeWrapper::computeTS()" << endl;
         if (ptrObjArr->GetEntries() == 0)
             return 0;
 
@@ -67,7 +70,7 @@ namespace R3BCalifaTimestitcher
             {
                 R3BCalifaMappedData* rawHit = dynamic_cast<R3BCalifaMappedData*>(ptrObjArr->At(0));
                 if (!rawHit)
-                    throw runtime_error("R3BTreeWrapper::getTS(): Could not cast to R3BCalifaMappedData!");
+                    throw runtime_error("R3BTreeWrapper::computeTS(): Could not cast to R3BCalifaMappedData!");
 
                 return rawHit->GetTime();
                 break;
@@ -77,7 +80,7 @@ namespace R3BCalifaTimestitcher
             {
                 R3BCalifaCrystalCalData* crystalHit = dynamic_cast<R3BCalifaCrystalCalData*>(ptrObjArr->At(0));
                 if (!crystalHit)
-                    throw runtime_error("R3BTreeWrapper::getTS(): Could not cast to R3BCalifaCrystalCalData!");
+                    throw runtime_error("R3BTreeWrapper::computeTS(): Could not cast to R3BCalifaCrystalCalData!");
 
                 return crystalHit->GetTime();
                 break;
@@ -87,14 +90,14 @@ namespace R3BCalifaTimestitcher
             {
                 R3BCalifaHitData* califaHit = dynamic_cast<R3BCalifaHitData*>(ptrObjArr->At(0));
                 if (!califaHit)
-                    throw runtime_error("R3BTreeWrapper::getTS(): Could not cast to R3BCalifaHitData!");
+                    throw runtime_error("R3BTreeWrapper::computeTS(): Could not cast to R3BCalifaHitData!");
 
                 return califaHit->GetTime();
                 break;
             }
 
             default:
-                throw runtime_error("R3BTreeWrapper::getTS(): Invalid branch type!");
+                throw runtime_error("R3BTreeWrapper::computeTS(): Invalid branch type!");
         }
     }
 
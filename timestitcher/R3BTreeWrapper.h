@@ -35,12 +35,11 @@ namespace R3BCalifaTimestitcher
         ArrayType type;
 
         virtual bool isGood();
+        virtual uint64_t computeTS();
         Int_t* ptrN;
 
       public:
         R3BTreeWrapper(TTree* tree, branchptrmap_t& branchmap, uint32_t id);
-
-        virtual uint64_t getTS();
     };
 } // namespace R3BCalifaTimestitcher
 
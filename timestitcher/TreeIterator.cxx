@@ -11,6 +11,8 @@
  * or submit itself to any jurisdiction.                                      *
  ******************************************************************************/
 
+#include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "TreeIterator.h"
@@ -19,50 +21,93 @@ using namespace std;
 
 namespace R3BCalifaTimestitcher
 {
-    TreeIterator::TreeIterator(vector<TreeWrapper*>& _trees)
-        : trees(_trees)
+    namespace
     {
+        typedef greater<pair<uint64_t, uint32_t>> later;
     }
 
-    TreeWrapper* TreeIterator::first()
+    TreeIterator::TreeIterator(vector<TreeWrapper*>& _trees, uint64_t _window)
+        : trees(_trees)
+        , window(_window)
+        , tsMax(0)
     {
-        TreeWrapper* t_min = NULL;
-        uint64_t ts_min = 0, cts;
+    }
 
+    bool TreeIterator::fill()
+    {
+        heap.clear();
+        tsMax = 0;
         for (unsigned int i = 0; i < trees.size(); i++)
         {
             if (!trees[i]->next())
-                return NULL;
-
-            cts = trees[i]->getTS();
-            if (ts_min == 0 || cts < ts_min)
-            {
-                ts_min = cts;
-                t_min = trees[i];
-            }
+                return false;
+            uint64_t ts = trees[i]->getTS();
+            heap.push_back(make_pair(ts, i));
+            tsMax = max(tsMax, ts);
         }
-
-        return t_min;
+        make_heap(heap.begin(), heap.end(), later());
+        return true;
     }
 
-    TreeWrapper* TreeIterator::next()
+    bool TreeIterator::advanceFirst()
     {
-        TreeWrapper* t_min = NULL;
-        uint64_t ts_min = 0, cts;
+        // Ties go to the tree that was given first
+        pop_heap(heap.begin(), heap.end(), later());
+        auto& e = heap.back();
+        const uint64_t tsOld = e.first;
+        TreeWrapper* t = trees[e.second];
+        if (!t->next())
+        {
+            heap.pop_back();
+            return false;
+        }
+        e.first = t->getTS();
+        push_heap(heap.begin(), heap.end(), later());
 
-        for (unsigned int i = 0; i < trees.size(); i++)
+        if (e.first >= tsMax)
+            tsMax = e.first;
+        else if (tsOld == tsMax)
         {
-            cts = trees[i]->getTS();
-            if (ts_min == 0 || cts < ts_min)
-            {
-                ts_min = cts;
-                t_min = trees[i];
-            }
+            // The timestamps of this tree are not ordered, find the new maximum
+            tsMax = 0;
+            for (auto& h : heap)
+                tsMax = max(tsMax, h.first);
         }
+        return true;
+    }
 
-        if (!t_min || !t_min->next())
+    TreeWrapper* TreeIterator::first()
+    {
+        if (!fill() || heap.empty())
+            return NULL;
+        for (auto t : trees)
+            t->load();
+        return trees[heap.front().second];
+    }
+
+    TreeWrapper* TreeIterator::next()
+    {
+        if (heap.empty())
+            return NULL;
+        const uint32_t i = heap.front().second;
+        if (!advanceFirst())
             return NULL;
+        trees[i]->load();
+        return trees[i];
+    }
+
+    bool TreeIterator::nextEvent()
+    {
+        // All entries of the last event are used up
+        if (!fill() || heap.empty())
+            return false;
+
+        while (tsMax - heap.front().first >= window)
+            if (!advanceFirst())
+                return false;
 
-        return t_min;
+        for (auto t : trees)
+            t->load();
+        return true;
     }
 } // namespace R3BCalifaTimestitcher
@@ -14,6 +14,7 @@
 #ifndef TREEITERATOR_H_
 #define TREEITERATOR_H_
 
+#include <utility>
 #include <vector>
 
 #include "TreeWrapper.h"
@@ -21,15 +22,50 @@
 namespace R3BCalifaTimestitcher
 {
 
+    /**
+     * Merges the input trees in order of their timestamps.
+     *
+     * The current entries of the trees are kept in a min-heap of
+     * (timestamp, tree), so each step costs O(log(number of trees)).
+     */
     class TreeIterator
     {
       protected:
         std::vector<TreeWrapper*>& trees;
 
+        // Coincidence window for nextEvent(), in units of the timestamps
+        uint64_t window;
+
+        // (timestamp, index in trees) of the current entry of each tree
+        std::vector<std::pair<uint64_t, uint32_t>> heap;
+        // Largest timestamp of the current entries
+        uint64_t tsMax;
+
+        bool fill();
+        bool advanceFirst();
+
       public:
-        TreeIterator(std::vector<TreeWrapper*>& trees);
+        TreeIterator(std::vector<TreeWrapper*>& trees, uint64_t window = 500);
+
+        // Step through the entries of all trees in order of their timestamps.
+        // Each step advances the tree with the earliest entry and returns it,
+        // the current entries of all trees are loaded completely.
         TreeWrapper* first();
         TreeWrapper* next();
+
+        /**
+         * Builds the next event: advances the trees until the current entries
+         * of all trees lie within the coincidence window, then loads these
+         * entries completely. Each entry is used in at most one event, an
+         * entry that cannot coincide with any later entry of the other trees
+         * is skipped.
+         *
+         * @return false once one of the trees is exhausted
+         */
+        bool nextEvent();
+
+        void setWindow(uint64_t _window) { window = _window; }
+        uint64_t getWindow() const { return window; }
     };
 
 } // namespace R3BCalifaTimestitcher
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include <exception>
+#include <iostream>
+
+#include "TreeReader.h"
+
+using namespace std;
+
+namespace R3BCalifaTimestitcher
+{
+    TreeReader::TreeReader(TreeWrapper* _source, size_t _capacity)
+        : source(_source)
+        , capacity(_capacity > 0 ? _capacity : 1)
+        , done(false)
+        , stop(false)
+    {
+        thread = std::thread(&TreeReader::run, this);
+    }
+
+    TreeReader::~TreeReader()
+    {
+        {
+            lock_guard<std::mutex> lock(mutex);
+            stop = true;
+        }
+        notFull.notify_all();
+        if (thread.joinable())
+            thread.join();
+        delete source;
+    }
+
+    void TreeReader::run()
+    {
+        try
+        {
+            while (source->next())
+            {
+                unique_lock<std::mutex> lock(mutex);
+                notFull.wait(lock, [this] { return stop || queue.size() < capacity; });
+                if (stop)
+                    break;
+                queue.emplace_back(source->getEntry(), source->getTS());
+                lock.unlock();
+                notEmpty.notify_one();
+            }
+        }
+        catch (exception& e)
+        {
+            cerr << "TreeReader: Input " << source->getId() << " stopped: " << e.what() << endl;
+        }
+
+        {
+            lock_guard<std::mutex> lock(mutex);
+            done = true;
+        }
+        notEmpty.notify_all();
+    }
+
+    bool TreeReader::pop(uint64_t& entry, uint64_t& ts)
+    {
+        unique_lock<std::mutex> lock(mutex);
+        notEmpty.wait(lock, [this] { return done || !queue.empty(); });
+        if (queue.empty())
+            return false;
+        entry = queue.front().first;
+        ts = queue.front().second;
+        queue.pop_front();
+        lock.unlock();
+        notFull.notify_one();
+        return true;
+    }
+} // namespace R3BCalifaTimestitcher
@@ -0,0 +1,70 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef TREEREADER_H_
+#define TREEREADER_H_
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <stdint.h>
+#include <thread>
+#include <utility>
+
+#include "TreeWrapper.h"
+
+namespace R3BCalifaTimestitcher
+{
+
+    /**
+     * Searches the good entries of an input tree on a separate thread.
+     *
+     * The reader steps through its own TreeWrapper, which must use a TFile
+     * handle and buffers of its own, and so only reads the selection
+     * branches. Entry numbers and timestamps of the good entries are passed
+     * on through a bounded queue, see TreeWrapper::setReader.
+     *
+     * ROOT::EnableThreadSafety() has to be called before the first reader is
+     * created.
+     */
+    class TreeReader
+    {
+      protected:
+        TreeWrapper* source;
+        size_t capacity;
+
+        // (entry, timestamp) of the good entries not taken yet
+        std::deque<std::pair<uint64_t, uint64_t>> queue;
+        bool done;
+        bool stop;
+
+        std::mutex mutex;
+        std::condition_variable notEmpty;
+        std::condition_variable notFull;
+        std::thread thread;
+
+        void run();
+
+      public:
+        // Takes ownership of source and starts reading
+        TreeReader(TreeWrapper* source, size_t capacity = 10000);
+        ~TreeReader();
+
+        // Next good entry, waits for the reader if necessary.
+        // Returns false once the tree is exhausted.
+        bool pop(uint64_t& entry, uint64_t& ts);
+    };
+
+} // namespace R3BCalifaTimestitcher
+
+#endif
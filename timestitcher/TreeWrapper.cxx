@@ -12,7 +12,9 @@
  ******************************************************************************/
 
 #include <iostream>
+#include <stdexcept>
 
+#include "TreeReader.h"
 #include "TreeWrapper.h"
 
 using namespace std;
@@ -24,28 +26,78 @@ namespace R3BCalifaTimestitcher
         : tree(_tree)
         , idx(0)
         , id(_id)
+        , current(0)
+        , ts(0)
+        , loaded(false)
+        , reader(NULL)
     {
         this->nEntries = tree->GetEntries();
     }
 
-    uint64_t TreeWrapper::getTS() { return *ptrTS; }
+    void TreeWrapper::addSelectionBranch(const char* name)
+    {
+        TBranch* b = tree->GetBranch(name);
+        if (!b)
+            throw runtime_error(string("TreeWrapper: Could not find branch ") + name + "!");
+        selectionBranches.push_back(b);
+    }
+
+    void TreeWrapper::enableCache(Long64_t cacheSize, bool selectionOnly)
+    {
+        tree->SetCacheSize(cacheSize);
+        if (selectionOnly && !selectionBranches.empty())
+            for (auto b : selectionBranches)
+                tree->AddBranchToCache(b, kTRUE);
+        else
+            tree->AddBranchToCache("*", kTRUE);
+        tree->StopCacheLearningPhase();
+    }
+
+    uint64_t TreeWrapper::computeTS() { return *ptrTS; }
 
     bool TreeWrapper::next()
     {
         //      cerr << "TreeWrapper::next()" << endl;
-        //      Long64_t treeIdx;
+        if (reader)
+        {
+            loaded = false;
+            return reader->pop(current, ts);
+        }
+
         while (idx < nEntries)
         {
             //         cerr << " idx = " << idx << endl;
-            //         treeIdx = tree->LoadTree(idx++);
-            //         cerr << " treeIdx = " << treeIdx << endl;
-            tree->GetEntry(idx++);
+            current = idx++;
+            if (selectionBranches.empty())
+            {
+                tree->GetEntry(current);
+                loaded = true;
+            }
+            else
+            {
+                // Everything else is only read if the entry is used, see load()
+                tree->LoadTree(current);
+                for (auto b : selectionBranches)
+                    b->GetEntry(current);
+                loaded = false;
+            }
             if (isGood())
+            {
+                ts = computeTS();
                 return true;
+            }
         }
         return false;
     }
 
+    void TreeWrapper::load()
+    {
+        if (loaded)
+            return;
+        tree->GetEntry(current);
+        loaded = true;
+    }
+
     uint32_t TreeWrapper::getId() { return id; }
 
 } // namespace R3BCalifaTimestitcher
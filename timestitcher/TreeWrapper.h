@@ -15,6 +15,7 @@
 #define TREEWRAPPER_H_
 
 #include <stdint.h>
+#include <vector>
 
 #include <TTree.h>
 
@@ -22,6 +23,7 @@ using namespace std;
 
 namespace R3BCalifaTimestitcher
 {
+    class TreeReader;
 
     class TreeWrapper
     {
@@ -33,16 +35,46 @@ namespace R3BCalifaTimestitcher
 
         uint32_t id;
 
+        // Branches needed by getTS() and isGood(), the only ones read
+        // while searching for the next good entry. Empty: read all.
+        std::vector<TBranch*> selectionBranches;
+        // Entry that is selected, its timestamp and whether all its branches are read
+        uint64_t current;
+        uint64_t ts;
+        bool loaded;
+
+        // If set, the good entries are found by this reader instead
+        TreeReader* reader;
+
         TreeWrapper(TTree* tree, uint32_t id);
 
+        void addSelectionBranch(const char* name);
+
         virtual bool isGood() = 0;
+        // Timestamp of the entry in the buffers
+        virtual uint64_t computeTS();
 
       public:
-        virtual uint64_t getTS();
+        // Timestamp of the entry selected by next()
+        uint64_t getTS() const { return ts; }
+        uint64_t getEntry() const { return current; }
+        TTree* getTree() { return tree; }
+
         virtual bool next();
 
+        // Reads all branches of the entry selected by next()
+        virtual void load();
+
         virtual uint32_t getId();
 
+        // Take the good entries from a reader working on another handle of the
+        // same tree, the wrapper itself then only reads entries in load()
+        void setReader(TreeReader* _reader) { reader = _reader; }
+
+        // Read through a TTreeCache of the given size [bytes], holding either
+        // all branches or only the selection branches
+        void enableCache(Long64_t cacheSize, bool selectionOnly = false);
+
         virtual ~TreeWrapper(){};
     };
 
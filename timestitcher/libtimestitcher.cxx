@@ -54,7 +54,8 @@ namespace R3BCalifaTimestitcher
             fprintf(stderr, "%s: Tree has no branches!\n", prefix.c_str());
             return;
         }
-        fprintf(stderr, "%s: merging %p into %p\n", prefix.c_str(), input, merged);
+        if (merged)
+            fprintf(stderr, "%s: merging %p into %p\n", prefix.c_str(), input, merged);
 
         for (int i = 0; i < branches->GetEntries(); i++)
         {
@@ -73,11 +74,13 @@ namespace R3BCalifaTimestitcher
                 {
                     const char* typeName = be->GetClonesName();
                     printf("TClonesArray, Basetype: %s\n", typeName);
-                    TClonesArray* ta = new TClonesArray(typeName, 50);
-                    be->SetAddress(&ta);
+                    // The branch keeps the address of the pointer, so it has to outlive this function
+                    TClonesArray** ta = new TClonesArray*(new TClonesArray(typeName, 50));
+                    be->SetAddress(ta);
                     input->SetBranchStatus(orgName.c_str(), 1);
-                    merged->Branch(name.c_str(), ta);
-                    branchmap[orgName] = ta;
+                    if (merged)
+                        merged->Branch(name.c_str(), *ta);
+                    branchmap[orgName] = *ta;
                 }
             }
             else
@@ -99,7 +102,8 @@ namespace R3BCalifaTimestitcher
                 b->SetAddress(buf);
                 fprintf(stderr, "%s %s %p %lld\n", name.c_str(), title.c_str(), buf, bufsize);
                 input->SetBranchStatus(orgName.c_str(), 1);
-                merged->Branch(name.c_str(), buf, title.c_str());
+                if (merged)
+                    merged->Branch(name.c_str(), buf, title.c_str());
                 branchmap[orgName] = buf;
                 // new TBranch(merged, name, buf, title);
                 // fprintf(stderr, "merged %s %s %x -> %x\n", b->GetName(),
@@ -25,6 +25,8 @@ namespace R3BCalifaTimestitcher
 
     void prefixString(std::string& s0, const std::string& prefix);
     int fillClonesArray();
+    // Allocate buffers for the branches of input and add them to merged with prefixed names.
+    // merged may be NULL to only set up the buffers, e.g. for a TreeReader.
     void addTreeBranches(TTree* merged, TTree* input, std::string prefix, branchptrmap_t& branchmap);
     TTree* findTree(std::string name);
     //   int cloneTreeBranches();
@@ -61,6 +61,7 @@ R3BTofdMapped2Cal::R3BTofdMapped2Cal()
     , fTrigger(-1)
     , fClockFreq(1. / VFTX_CLOCK_MHZ * 1000.)
     , fCalLookup()
+    , fFineTimes()
 {
 }
 
@@ -77,6 +78,7 @@ R3BTofdMapped2Cal::R3BTofdMapped2Cal(const char* name, Int_t iVerbose)
     , fTrigger(-1)
     , fClockFreq(1. / VFTX_CLOCK_MHZ * 1000.)
     , fCalLookup()
+    , fFineTimes()
 {
 }
 
@@ -172,6 +174,16 @@ void R3BTofdMapped2Cal::Exec(Option_t* option)
         double time_ns;
     };
     std::vector<std::vector<Cal>> cal_vec(fNofPlanes * fPaddlesPerPlane * 2);
+    fTcalPar->Calibrate<R3BTofdMappedData>(
+        fMappedItems,
+        [](R3BTofdMappedData const* mapped) {
+            return R3BTCalPar::Channel(mapped->GetDetectorId(),
+                                       mapped->GetBarId(),
+                                       2 * mapped->GetSideId() + mapped->GetEdgeId() - 2,
+                                       mapped->GetTimeFine());
+        },
+        &R3BTCalModulePar::GetTimeVFTX,
+        fFineTimes);
     for (Int_t mapped_i = 0; mapped_i < mapped_num; mapped_i++)
     {
         auto mapped = (R3BTofdMappedData const*)fMappedItems->At(mapped_i);
@@ -188,19 +200,15 @@ void R3BTofdMapped2Cal::Exec(Option_t* option)
             continue;
         }
 
-        // Tcal parameters.
-        auto* par = fTcalPar->GetModuleParAt(
-            mapped->GetDetectorId(), mapped->GetBarId(), 2 * mapped->GetSideId() + mapped->GetEdgeId() - 2);
-        if (!par)
+        // TDC converted to [ns] by Calibrate() above ...
+        Double_t time_ns = fFineTimes[mapped_i];
+        if (IS_NAN(time_ns))
         {
             LOG(ERROR) << "R3BTofdMapped2Cal::Exec : Tcal par not found, Plane: " << mapped->GetDetectorId()
                        << ", Bar: " << mapped->GetBarId() << ", Side: " << mapped->GetSideId()
                        << ", Edge: " << mapped->GetEdgeId();
             continue;
         }
-
-        // Convert TDC to [ns] ...
-        Double_t time_ns = par->GetTimeVFTX(mapped->GetTimeFine());
         // ... and subtract it from the next clock cycle.
         time_ns = (mapped->GetTimeCoarse() + 1) * fClockFreq - time_ns;
 
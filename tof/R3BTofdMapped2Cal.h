@@ -135,6 +135,9 @@ class R3BTofdMapped2Cal : public FairTask
     // Fast lookup for matching mapped data.
     std::vector<std::vector<R3BTofdCalData*>> fCalLookup;
 
+    // Fine times [ns] of the mapped items, reused between events.
+    std::vector<Double_t> fFineTimes;
+
   public:
     ClassDef(R3BTofdMapped2Cal, 1)
 };
@@ -19,12 +19,18 @@
 
 #include "R3BFragmentFitterChi2.h"
 
+#include "TROOT.h"
+
+#include <atomic>
+#include <thread>
+
 #define SPEED_OF_LIGHT 29.9792458 // cm/ns
 #define Amu 0.938272
 
-R3BTrackingParticle* gCandidate;
-R3BTrackingSetup* gSetup;
-R3BTPropagator* gProp;
+// State of the fit running in the current thread
+thread_local R3BTrackingParticle* gCandidate;
+thread_local R3BTrackingSetup* gSetup;
+thread_local R3BTPropagator* gProp;
 
 Bool_t gEnergyLoss;
 
@@ -329,30 +335,88 @@ double Chi2Backward2D(const double* xx)
     return chi2;
 }
 
-R3BFragmentFitterChi2::R3BFragmentFitterChi2() {}
+R3BFragmentFitterChi2::R3BFragmentFitterChi2()
+    : fMinimum(nullptr)
+    , fPropagator(nullptr)
+    , fEnergyLoss(kTRUE)
+    , fNofThreads(1)
+{
+}
 
-R3BFragmentFitterChi2::~R3BFragmentFitterChi2() {}
+R3BFragmentFitterChi2::~R3BFragmentFitterChi2()
+{
+    delete fMinimum;
+    DeleteWorkers();
+}
 
 void R3BFragmentFitterChi2::Init(R3BTPropagator* prop, Bool_t energyLoss)
 {
     fPropagator = prop;
+    fEnergyLoss = energyLoss;
     gProp = prop;
     gEnergyLoss = energyLoss;
 
-    fMinimum = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Migrad");
+    delete fMinimum;
+    fMinimum = CreateMinimizer();
+    CreateWorkers();
+}
+
+void R3BFragmentFitterChi2::SetNofThreads(Int_t nThreads)
+{
+    fNofThreads = nThreads;
+    if (fMinimum)
+    {
+        CreateWorkers();
+    }
+}
+
+void R3BFragmentFitterChi2::CreateWorkers()
+{
+    DeleteWorkers();
+    if (fNofThreads <= 1 || !fPropagator)
+    {
+        return;
+    }
+
+    // Minimizers and propagators are created here, the plugin manager
+    // and the canvas of the propagator are not to be used from workers.
+    ROOT::EnableThreadSafety();
+    for (Int_t i = 0; i < fNofThreads; i++)
+    {
+        fWorkerMinimizers.push_back(CreateMinimizer());
+        fWorkerPropagators.push_back(new R3BTPropagator(fPropagator->GetField(), kFALSE));
+    }
+}
+
+void R3BFragmentFitterChi2::DeleteWorkers()
+{
+    for (size_t i = 0; i < fWorkerMinimizers.size(); i++)
+    {
+        delete fWorkerMinimizers[i];
+        delete fWorkerPropagators[i];
+    }
+    fWorkerMinimizers.clear();
+    fWorkerPropagators.clear();
+}
+
+ROOT::Math::Minimizer* R3BFragmentFitterChi2::CreateMinimizer() const
+{
+    ROOT::Math::Minimizer* minimum = ROOT::Math::Factory::CreateMinimizer("Minuit2", "Migrad");
 
     // set tolerance , etc...
-    fMinimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
-    fMinimum->SetMaxIterations(10000);      // for GSL
-    fMinimum->SetTolerance(10.);
-    fMinimum->SetPrintLevel(0);
-    fMinimum->SetStrategy(0);
+    minimum->SetMaxFunctionCalls(1000000); // for Minuit/Minuit2
+    minimum->SetMaxIterations(10000);      // for GSL
+    minimum->SetTolerance(10.);
+    minimum->SetPrintLevel(0);
+    minimum->SetStrategy(0);
 
     // create funciton wrapper for minmizer
-    // a IMultiGenFunction type
-    ROOT::Math::Functor* f = new ROOT::Math::Functor(&Chi2Backward2D, 2);
+    // a IMultiGenFunction type, the minimizer keeps a copy
+    ROOT::Math::Functor f(&Chi2Backward2D, 2);
+
+    minimum->SetFunction(f);
 
-    fMinimum->SetFunction(*f);
+    return minimum;
 }
 
 Int_t R3BFragmentFitterChi2::FitTrack(R3BTrackingParticle* particle, R3BTrackingSetup* setup)
@@ -548,6 +612,50 @@ Int_t R3BFragmentFitterChi2::FitTrackBackward(R3BTrackingParticle* particle, R3B
 }
 
 Int_t R3BFragmentFitterChi2::FitTrackBackward2D(R3BTrackingParticle* particle, R3BTrackingSetup* setup)
+{
+    return FitTrackBackward2D(particle, setup, fMinimum);
+}
+
+void R3BFragmentFitterChi2::FitTracksBackward2D(const std::vector<R3BTrackingParticle*>& particles,
+                                                R3BTrackingSetup* setup,
+                                                std::vector<Int_t>& status)
+{
+    status.assign(particles.size(), 0);
+
+    const Int_t nThreads = TMath::Min((Int_t)particles.size(), (Int_t)fWorkerMinimizers.size());
+    if (nThreads <= 1)
+    {
+        for (size_t i = 0; i < particles.size(); i++)
+        {
+            status[i] = FitTrackBackward2D(particles[i], setup, fMinimum);
+        }
+        return;
+    }
+
+    // Every candidate is fitted into its own slot, so the result does not
+    // depend on the number of threads.
+    std::atomic<size_t> next(0);
+    auto worker = [&](Int_t iThread) {
+        gProp = fWorkerPropagators[iThread];
+        for (size_t i = next++; i < particles.size(); i = next++)
+        {
+            status[i] = FitTrackBackward2D(particles[i], setup, fWorkerMinimizers[iThread]);
+        }
+    };
+    std::vector<std::thread> threads;
+    for (Int_t i = 0; i < nThreads; i++)
+    {
+        threads.emplace_back(worker, i);
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+}
+
+Int_t R3BFragmentFitterChi2::FitTrackBackward2D(R3BTrackingParticle* particle,
+                                                R3BTrackingSetup* setup,
+                                                ROOT::Math::Minimizer* minimum)
 {
     // fPropagator->SetVis(kTRUE);
 
@@ -566,8 +674,8 @@ Int_t R3BFragmentFitterChi2::FitTrackBackward2D(R3BTrackingParticle* particle, R
     double step[2] = { 0.01, 0.001 };
 
     // Set the free variables to be minimized!
-    fMinimum->SetLimitedVariable(0, "m", variable[0], step[0], 125. * amu, 133. * amu);
-    fMinimum->SetLimitedVariable(1, "xfi6", variable[1], step[1], -100., 100.);
+    minimum->SetLimitedVariable(0, "m", variable[0], step[0], 125. * amu, 133. * amu);
+    minimum->SetLimitedVariable(1, "xfi6", variable[1], step[1], -100., 100.);
 
     TVector3 pos2;
     TVector3 pos3;
@@ -614,20 +722,20 @@ Int_t R3BFragmentFitterChi2::FitTrackBackward2D(R3BTrackingParticle* particle, R
     Int_t status = 0;
 
     // do the minimization
-    fMinimum->Minimize();
+    minimum->Minimize();
 
     gCandidate->SetCharge(-1. * gCandidate->GetCharge());
 
-    status = fMinimum->Status();
+    status = minimum->Status();
     if (0 != status)
     {
         return status;
     }
 
-    particle->SetMass(fMinimum->X()[0]);
+    particle->SetMass(minimum->X()[0]);
     particle->UpdateMomentum();
 
-    fMinimum->Clear();
+    minimum->Clear();
 
     // candidate->Reset();
 
@@ -37,6 +37,17 @@ class R3BFragmentFitterChi2 : public R3BFragmentFitterGeneric
     
     Int_t FitTrackBackward2D(R3BTrackingParticle*, R3BTrackingSetup*);
 
+    /* Fits the candidates in SetNofThreads() threads, each with its own
+     * minimizer and propagator. */
+    void FitTracksBackward2D(const std::vector<R3BTrackingParticle*>& particles,
+                             R3BTrackingSetup* setup,
+                             std::vector<Int_t>& status);
+
+    /* Number of threads for FitTracksBackward2D, 1 by default. The
+     * minimizers and propagators of the threads are created once, by Init()
+     * or by this method after Init(). */
+    void SetNofThreads(Int_t nThreads);
+
     Double_t TrackFragment(R3BTrackingParticle* particle,
                            Bool_t energyLoss,
                            Double_t& devTof,
@@ -51,8 +62,18 @@ class R3BFragmentFitterChi2 : public R3BFragmentFitterGeneric
     Double_t Velocity(R3BTrackingParticle* candidate);
 
   private:
+    ROOT::Math::Minimizer* CreateMinimizer() const;
+    void CreateWorkers();
+    void DeleteWorkers();
+
+    Int_t FitTrackBackward2D(R3BTrackingParticle*, R3BTrackingSetup*, ROOT::Math::Minimizer* minimum);
+
     ROOT::Math::Minimizer* fMinimum;
     R3BTPropagator* fPropagator;
+    Bool_t fEnergyLoss;
+    Int_t fNofThreads;
+    std::vector<ROOT::Math::Minimizer*> fWorkerMinimizers; //! One per thread of FitTracksBackward2D
+    std::vector<R3BTPropagator*> fWorkerPropagators;       //!
    	Double_t amu = 0.938272;
 
     ClassDef(R3BFragmentFitterChi2, 1)
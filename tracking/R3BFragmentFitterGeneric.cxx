@@ -20,3 +20,14 @@ ClassImp(R3BFragmentFitterGeneric)
 }
 
 R3BFragmentFitterGeneric::~R3BFragmentFitterGeneric() {}
+
+void R3BFragmentFitterGeneric::FitTracksBackward2D(const std::vector<R3BTrackingParticle*>& particles,
+                                                   R3BTrackingSetup* setup,
+                                                   std::vector<Int_t>& status)
+{
+    status.resize(particles.size());
+    for (size_t i = 0; i < particles.size(); i++)
+    {
+        status[i] = FitTrackBackward2D(particles[i], setup);
+    }
+}
@@ -16,6 +16,8 @@
 
 #include "Rtypes.h"
 
+#include <vector>
+
 class R3BTrackingParticle;
 class R3BTrackingSetup;
 class R3BTPropagator;
@@ -36,6 +38,13 @@ class R3BFragmentFitterGeneric
     
     virtual Int_t FitTrackBackward2D(R3BTrackingParticle*, R3BTrackingSetup*) = 0;
 
+    /* Fit independent candidates with FitTrackBackward2D. The status of
+     * each fit is returned at the index of its candidate. Implementations
+     * may fit the candidates concurrently. */
+    virtual void FitTracksBackward2D(const std::vector<R3BTrackingParticle*>& particles,
+                                     R3BTrackingSetup* setup,
+                                     std::vector<Int_t>& status);
+
     ClassDef(R3BFragmentFitterGeneric, 1)
 };
 
@@ -31,6 +31,9 @@
 #include "R3BTrackingDetector.h"
 #include "R3BTrackingParticle.h"
 #include "R3BTrackingSetup.h"
+#ifdef WITH_ATIMA
+#include "R3BTrackingEnergyLoss.h"
+#endif
 
 #include "FairLogger.h"
 #include "FairRootManager.h"
@@ -62,6 +65,12 @@ R3BFragmentTracker::R3BFragmentTracker(const char* name, Bool_t vis, Int_t verbo
     , fVis(vis)
     , fFitter(nullptr)
     , fEnergyLoss(kTRUE)
+    , fEnergyLossTable(nullptr)
+    , fAfterGladResolution(0.)
+    , fCandidateTolerance(10.)
+    , fMaxDevFi4(0.)
+    , fMaxDevTof(0.)
+    , fNofCandidates(0)
 {
     // this is the list of detectors (active areas) we use for tracking
     fDetectors->AddDetector("target", kTarget, "TargetGeoPar");
@@ -72,7 +81,13 @@ R3BFragmentTracker::R3BFragmentTracker(const char* name, Bool_t vis, Int_t verbo
     fDetectors->AddDetector("tofd", kTof, "tofdGeoPar", "TofdHit");
 }
 
-R3BFragmentTracker::~R3BFragmentTracker() {}
+R3BFragmentTracker::~R3BFragmentTracker()
+{
+    for (auto const& x : fCandidatePool)
+    {
+        delete x;
+    }
+}
 
 /* For the tracking we use a user-defined list of TrackingDetectors,
  * stored in a TClonesArrays. The TrackingDetectors will provide
@@ -127,6 +142,15 @@ InitStatus R3BFragmentTracker::Init()
 
     fDetectors->Init();
 
+    if (fEnergyLossTable)
+    {
+#ifdef WITH_ATIMA
+        fEnergyLossTable->Init(fDetectors);
+#else
+        LOG(ERROR) << "R3BFragmentTracker: built without ATIMA, energy loss tables are not available";
+#endif
+    }
+
     fh_mult_psp = new TH1F("h_mult_psp", "Multiplicity PSP", 20, -0.5, 19.5);
     fh_mult_fi4 = new TH1F("h_mult_fi4", "Multiplicity Fi4", 20, -0.5, 19.5);
     fh_mult_fi5 = new TH1F("h_mult_fi5", "Multiplicity Fi5", 20, -0.5, 19.5);
@@ -182,14 +206,7 @@ void R3BFragmentTracker::SetParContainers()
 void R3BFragmentTracker::Exec(const Option_t*)
 {
     fArrayFragments->Clear();
-    if (fFragments.size() > 0)
-    {
-        for (auto const& x : fFragments)
-        {
-            delete x;
-        }
-        fFragments.clear();
-    }
+    fFragments.clear();
 
     /* this part needs to be adopted to each experiment / setup
      *
@@ -251,130 +268,119 @@ void R3BFragmentTracker::Exec(const Option_t*)
      * independently. Pity.
      */
 
-    // try to fit all possible combination of hits. (For now just one)
-    // for (all psp hits)
-    //    for (all tof hits)
+    // try to fit all possible combination of hits.
     fPropagator->SetVis(kFALSE);
 
-    Int_t nCand = 0;
+    tof->res_t = 0.03;
+    Double_t velocity0 = 0.8328 + 0.0003;
+
+    // Prepare the candidate filter: the hit positions in the bending plane
+    // and the allowed deviations from a straight line behind GLAD
+    fPosTarget = target->pos0;
+    GetHitPositions(psp, fPosPsp);
+    GetHitPositions(fi4, fPosFi4);
+    GetHitPositions(fi5, fPosFi5);
+    GetHitPositions(fi6, fPosFi6);
+    GetHitPositions(tof, fPosTof);
+    fUsePsp.resize(psp->hits.size());
+    for (Int_t i = 0; i < psp->hits.size(); i++)
+    {
+        fUsePsp[i] = psp->hits.at(i)->GetEloss() > 30.;
+    }
+    fAfterGladResolution = fDetectors->GetAfterGladResolution();
+    fMaxDevFi4 = fCandidateTolerance * TMath::Sqrt(TMath::Power(fi4->res_x, 2) + TMath::Power(fAfterGladResolution, 2));
+    fMaxDevTof = fCandidateTolerance * TMath::Sqrt(TMath::Power(tof->res_x, 2) + TMath::Power(fAfterGladResolution, 2));
+
+    // Candidates of the previous event go back to the pool
+    fNofCandidates = 0;
+    fCandidates.clear();
 
-    Int_t ipsp = 0;
-    Int_t ifi4 = 0;
-    Int_t ifi5 = 0;
-    Int_t ifi6 = 0;
-    Int_t itof = 0;
-    if (0 == psp->hits.size())
-        ipsp = -1;
-    if (0 == fi4->hits.size())
-        ifi4 = -1;
-    if (0 == fi5->hits.size())
-        ifi5 = -1;
-    if (0 == fi6->hits.size())
-        ifi6 = -1;
-    if (0 == tof->hits.size())
-        itof = -1;
+    Int_t nCand = 0;
 
+    // A detector without hits takes part with hit index -1
+    for (Int_t ipsp = psp->hits.empty() ? -1 : 0; ipsp < (Int_t)psp->hits.size(); ipsp++)
     {
-        do
+        if (ipsp >= 0)
+            fh_eloss_psp_mc->Fill(psp->hits.at(ipsp)->GetEloss()); // MeV
+
+        for (Int_t ifi4 = fi4->hits.empty() ? -1 : 0; ifi4 < (Int_t)fi4->hits.size(); ifi4++)
         {
-            if (ipsp >= 0)
-                fh_eloss_psp_mc->Fill(psp->hits.at(ipsp)->GetEloss()); // MeV
+            if (ifi4 >= 0)
+                fh_eloss_fi4_mc->Fill(fi4->hits.at(ifi4)->GetEloss()); // MeV
 
-            do
+            for (Int_t ifi5 = fi5->hits.empty() ? -1 : 0; ifi5 < (Int_t)fi5->hits.size(); ifi5++)
             {
-                if (ifi4 >= 0)
-                    fh_eloss_fi4_mc->Fill(fi4->hits.at(ifi4)->GetEloss()); // MeV
-
-                do
+                for (Int_t ifi6 = fi6->hits.empty() ? -1 : 0; ifi6 < (Int_t)fi6->hits.size(); ifi6++)
                 {
-                    do
+                    for (Int_t itof = tof->hits.empty() ? -1 : 0; itof < (Int_t)tof->hits.size(); itof++)
                     {
-                        do
+                        if (!IsPlausible(ipsp, ifi4, ifi5, ifi6, itof))
                         {
-                            tof->res_t = 0.03;
-
-                            Double_t velocity0 = 0.8328 + 0.0003;
-
-                            // Create object for particle which will be fitted
-                            R3BTrackingParticle* candidate = new R3BTrackingParticle(
-                                particle->GetCharge(), 0., 0., 0., 0., 0., 0., velocity0, 132. * Amu);
-
-                            candidate->AddHit("target", 0);
-                            if (ipsp >= 0)
-                            {
-                                if (psp->hits.at(ipsp)->GetEloss() > 30.)
-                                    candidate->AddHit("psp", ipsp);
-                                else
-                                    candidate->AddHit("psp", -1);
-                            }
-                            else
-                            {
-                                candidate->AddHit("psp", -1);
-                            }
-                            candidate->AddHit("fi4", ifi4);
-                            candidate->AddHit("fi5", ifi5);
-                            candidate->AddHit("fi6", ifi6);
-                            candidate->AddHit("tofd", itof);
-
-                            // find momentum
-                            // momin is only a first guess
-                            Int_t status = fFitter->FitTrackBackward2D(candidate, fDetectors);
-
-                            nCand += 1;
-
-                            if (TMath::IsNaN(candidate->GetMomentum().Z()))
-                            {
-                                delete candidate;
-                                continue;
-                            }
-
-                            if (0 == status)
-                            {
-                                candidate->SetStartPosition(candidate->GetPosition());
-                                candidate->SetStartMomentum(-1. * candidate->GetMomentum());
-                                // candidate->SetStartBeta(0.8328);
-                                candidate->SetStartBeta(velocity0);
-                                candidate->UpdateMomentum();
-                                candidate->Reset();
-
-                                // candidate->GetStartPosition().Print();
-                                // candidate->GetStartMomentum().Print();
-                                // cout << "chi2: " << candidate->GetChi2() << endl;
-                                // status = FitFragment(candidate);
-
-                                if (0 == status)
-                                {
-                                    // if(candidate->GetChi2() < 3.)
-                                    {
-                                        fFragments.push_back(candidate);
-                                    }
-                                }
-                                else
-                                {
-                                    delete candidate;
-                                }
-                            }
-                            else
-                            {
-                                delete candidate;
-                            }
-
-                            // return;
-                            itof += 1;
-                        } while (itof < tof->hits.size());
-                        ifi6 += 1;
-                    } while (ifi6 < fi6->hits.size());
-                    ifi5 += 1;
-                } while (ifi5 < fi5->hits.size());
-                ifi4 += 1;
-            } while (ifi4 < fi4->hits.size());
-            ipsp += 1;
-        } while (ipsp < psp->hits.size());
+                            continue;
+                        }
+
+                        // Create object for particle which will be fitted
+                        R3BTrackingParticle* candidate =
+                            NewCandidate(particle->GetCharge(), velocity0, 132. * Amu);
+
+                        candidate->AddHit("target", 0);
+                        if (ipsp >= 0 && fUsePsp[ipsp])
+                            candidate->AddHit("psp", ipsp);
+                        else
+                            candidate->AddHit("psp", -1);
+                        candidate->AddHit("fi4", ifi4);
+                        candidate->AddHit("fi5", ifi5);
+                        candidate->AddHit("fi6", ifi6);
+                        candidate->AddHit("tofd", itof);
+
+                        fCandidates.push_back(candidate);
+                    }
+                }
+            }
+        }
+    }
+
+    // find momentum
+    // momin is only a first guess
+    // The candidates are independent, the fitter may run them concurrently
+    fFitter->FitTracksBackward2D(fCandidates, fDetectors, fFitStatus);
+
+    for (size_t i = 0; i < fCandidates.size(); i++)
+    {
+        R3BTrackingParticle* candidate = fCandidates[i];
+        Int_t status = fFitStatus[i];
+
+        nCand += 1;
+
+        if (TMath::IsNaN(candidate->GetMomentum().Z()))
+        {
+            continue;
+        }
+
+        if (0 == status)
+        {
+            candidate->SetStartPosition(candidate->GetPosition());
+            candidate->SetStartMomentum(-1. * candidate->GetMomentum());
+            // candidate->SetStartBeta(0.8328);
+            candidate->SetStartBeta(velocity0);
+            candidate->UpdateMomentum();
+            candidate->Reset();
+
+            // candidate->GetStartPosition().Print();
+            // candidate->GetStartMomentum().Print();
+            // cout << "chi2: " << candidate->GetChi2() << endl;
+            // status = FitFragment(candidate);
+
+            // if(candidate->GetChi2() < 3.)
+            {
+                fFragments.push_back(candidate);
+            }
+        }
     }
 
     fh_ncand->Fill(nCand);
 
-    R3BTrackingParticle* candidate = new R3BTrackingParticle();
+    R3BTrackingParticle* candidate = NULL;
     Double_t minChi2 = 1e10;
 
     if (fFragments.size() > 0)
@@ -614,6 +620,98 @@ void R3BFragmentTracker::Finish()
     }
 }
 
+void R3BFragmentTracker::GetHitPositions(R3BTrackingDetector* det, std::vector<TVector3>& positions) const
+{
+    // As R3BTrackingDetector::LocalToGlobal, without the printout
+    positions.resize(det->hits.size());
+    for (Int_t i = 0; i < det->hits.size(); i++)
+    {
+        positions[i].SetXYZ(det->hits.at(i)->GetX(), 0., 0.);
+        positions[i].RotateY(det->GetGeoPar()->GetRotY() * TMath::DegToRad());
+        positions[i] += det->pos0;
+    }
+}
+
+Bool_t R3BFragmentTracker::IsPlausible(Int_t ipsp, Int_t ifi4, Int_t ifi5, Int_t ifi6, Int_t itof) const
+{
+    // The fit needs fi5 and fi6 for the initial position and direction
+    if (ifi5 < 0 || ifi6 < 0)
+    {
+        return kFALSE;
+    }
+
+    if (fCandidateTolerance <= 0.)
+    {
+        return kTRUE;
+    }
+
+    // Straight line behind GLAD in the bending (x-z) plane
+    const TVector3& p5 = fPosFi5[ifi5];
+    const TVector3& p6 = fPosFi6[ifi6];
+    Double_t ux = p5.X() - p6.X();
+    Double_t uz = p5.Z() - p6.Z();
+    const Double_t length = TMath::Sqrt(ux * ux + uz * uz);
+    if (length <= 0.)
+    {
+        return kFALSE;
+    }
+    ux /= length;
+    uz /= length;
+
+    // Distance of the other hits behind GLAD from the line
+    if (ifi4 >= 0 &&
+        TMath::Abs((fPosFi4[ifi4].X() - p6.X()) * uz - (fPosFi4[ifi4].Z() - p6.Z()) * ux) > fMaxDevFi4)
+    {
+        return kFALSE;
+    }
+    if (itof >= 0 &&
+        TMath::Abs((fPosTof[itof].X() - p6.X()) * uz - (fPosTof[itof].Z() - p6.Z()) * ux) > fMaxDevTof)
+    {
+        return kFALSE;
+    }
+
+    // The incoming line from the target through the PSP has to meet the
+    // outgoing line between the PSP and the first detector behind GLAD
+    if (ipsp >= 0 && fUsePsp[ipsp])
+    {
+        const TVector3& pPsp = fPosPsp[ipsp];
+        const Double_t vx = pPsp.X() - fPosTarget.X();
+        const Double_t vz = pPsp.Z() - fPosTarget.Z();
+        const Double_t cross = vx * uz - vz * ux;
+        const Double_t norm = TMath::Sqrt(vx * vx + vz * vz);
+
+        // Almost parallel lines give no useful constraint
+        if (TMath::Abs(cross) > 1e-3 * norm)
+        {
+            const Double_t t = ((p6.X() - fPosTarget.X()) * uz - (p6.Z() - fPosTarget.Z()) * ux) / cross;
+            const Double_t zKink = fPosTarget.Z() + t * vz;
+            Double_t zAfter = TMath::Min(p5.Z(), p6.Z());
+            if (ifi4 >= 0)
+            {
+                zAfter = TMath::Min(zAfter, fPosFi4[ifi4].Z());
+            }
+            if (zKink < pPsp.Z() || zKink > zAfter)
+            {
+                return kFALSE;
+            }
+        }
+    }
+
+    return kTRUE;
+}
+
+R3BTrackingParticle* R3BFragmentTracker::NewCandidate(Double_t charge, Double_t beta, Double_t mass)
+{
+    if (fNofCandidates == fCandidatePool.size())
+    {
+        fCandidatePool.push_back(new R3BTrackingParticle());
+    }
+    R3BTrackingParticle* candidate = fCandidatePool[fNofCandidates++];
+    // Assignment keeps the capacity of the hit list
+    *candidate = R3BTrackingParticle(charge, 0., 0., 0., 0., 0., 0., beta, mass);
+    return candidate;
+}
+
 Bool_t R3BFragmentTracker::InitPropagator()
 {
     FairField* fairField = FairRunAna::Instance()->GetField();
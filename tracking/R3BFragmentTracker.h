@@ -15,6 +15,7 @@
 #define R3B_FRAGMENTTRACKER_H
 
 #include "FairTask.h"
+#include "TVector3.h"
 
 #include <string>
 #include <vector>
@@ -26,6 +27,7 @@ class R3BTrackingDetector;
 class R3BTrackingParticle;
 class R3BTrackingSetup;
 class R3BFragmentFitterGeneric;
+class R3BTrackingEnergyLoss;
 
 class TH1F;
 
@@ -47,9 +49,31 @@ class R3BFragmentTracker : public FairTask
     void SetFragmentFitter(R3BFragmentFitterGeneric* fitter) { fFitter = fitter; }
     void SetEnergyLoss(Bool_t energyLoss) { fEnergyLoss = energyLoss; }
 
+    /** Take the energy loss of the known fragments from ATIMA tables,
+     ** calculated for the tracking setup in Init(). Not owned. **/
+    void SetEnergyLossTable(R3BTrackingEnergyLoss* table) { fEnergyLossTable = table; }
+
+    /** Tolerance of the pre-fit candidate filter, in units of the detector
+     ** resolution. Hit combinations deviating more from a straight line
+     ** behind GLAD are not fitted. 0 switches the filter off. **/
+    void SetCandidateTolerance(Double_t nSigma) { fCandidateTolerance = nSigma; }
+
   private:
     Bool_t InitPropagator();
 
+    /** Global positions of the hits of a detector on its plane **/
+    void GetHitPositions(R3BTrackingDetector* det, std::vector<TVector3>& positions) const;
+
+    /** Cheap geometric check of a hit combination before the fit.
+     ** Behind GLAD the track has to be a straight line through fi5 and fi6,
+     ** and in front of GLAD it has to meet the straight line from the target
+     ** through the PSP hit inside the field region.
+     ** Hit indices of -1 stand for no hit in that detector. **/
+    Bool_t IsPlausible(Int_t ipsp, Int_t ifi4, Int_t ifi5, Int_t ifi6, Int_t itof) const;
+
+    /** Take a candidate from the pool, valid until the next event **/
+    R3BTrackingParticle* NewCandidate(Double_t charge, Double_t beta, Double_t mass);
+
     R3BFieldPar* fFieldPar;
     R3BTPropagator* fPropagator;
     TClonesArray* fArrayMCTracks; // simulation output??? To compare?
@@ -63,8 +87,29 @@ class R3BFragmentTracker : public FairTask
 
     R3BFragmentFitterGeneric* fFitter;
     Bool_t fEnergyLoss;
+    R3BTrackingEnergyLoss* fEnergyLossTable;
 
     Double_t fAfterGladResolution;
+    Double_t fCandidateTolerance;
+
+    // Per event hit positions for the candidate filter
+    TVector3 fPosTarget;
+    std::vector<TVector3> fPosPsp;
+    std::vector<TVector3> fPosFi4;
+    std::vector<TVector3> fPosFi5;
+    std::vector<TVector3> fPosFi6;
+    std::vector<TVector3> fPosTof;
+    std::vector<Bool_t> fUsePsp;
+    Double_t fMaxDevFi4;
+    Double_t fMaxDevTof;
+
+    // Candidates are reused from event to event
+    std::vector<R3BTrackingParticle*> fCandidatePool;
+    size_t fNofCandidates;
+
+    // Candidates of the current event to be fitted, and the fit results
+    std::vector<R3BTrackingParticle*> fCandidates;
+    std::vector<Int_t> fFitStatus;
 
     TH1F* fh_mult_psp;
     TH1F* fh_mult_fi4;
@@ -21,7 +21,6 @@
 class R3BGladFieldMap;
 class FairRKPropagator;
 class R3BTGeoPar;
-class FairField;
 class R3BTrackingParticle;
 class R3BTrackingDetector;
 
@@ -58,10 +57,12 @@ class R3BTPropagator : public TObject
 
     void SetVis(Bool_t vis = kTRUE) { fVis = vis; }
 
+    R3BGladFieldMap* GetField() const { return fField; }
+
   private:
     FairRKPropagator* fFairProp;
 
-    FairField* fField;
+    R3BGladFieldMap* fField;
 
     R3BTGeoPar* fmTofGeo;
 
@@ -74,7 +75,7 @@ class R3BTPropagator : public TObject
 
     TCanvas* fc4;
 
-    ClassDef(R3BTPropagator, 1)
+    ClassDef(R3BTPropagator, 2)
 };
 
 #endif //! R3B_T_PROPAGATOR
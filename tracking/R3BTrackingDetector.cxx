@@ -14,6 +14,9 @@
 #include "R3BTrackingDetector.h"
 #include "R3BHit.h"
 #include "R3BTGeoPar.h"
+#ifdef WITH_ATIMA
+#include "R3BTrackingEnergyLoss.h"
+#endif
 
 #include "FairLogger.h"
 #include "FairRootManager.h"
@@ -35,6 +38,8 @@ R3BTrackingDetector::R3BTrackingDetector(const char* detectorName,
     , fGeoParName(geoParName)
     , fDataName(hitArray)
     , section(type)
+    , fEnergyLossTable(NULL)
+    , fEnergyLossIndex(-1)
     , fArrayHits(NULL)
 {
     // resolutions (for chi2)
@@ -122,12 +127,20 @@ void R3BTrackingDetector::LocalToGlobal(TVector3& posGlobal, Double_t x_local, D
     posGlobal = TVector3(x_local, y_local, 0.);
     posGlobal.RotateY(fGeo->GetRotY() * TMath::DegToRad());
     posGlobal = posGlobal + pos0;
-    std::cout << "Local x: " << x_local << " y: " << y_local << std::endl;
-    std::cout << "global x: " << posGlobal.X() << " y: " << posGlobal.Y() << " z: " << posGlobal.Z() << std::endl;
+    LOG(DEBUG2) << "Local x: " << x_local << " y: " << y_local;
+    LOG(DEBUG2) << "global x: " << posGlobal.X() << " y: " << posGlobal.Y() << " z: " << posGlobal.Z();
 }
 
-Double_t R3BTrackingDetector::GetEnergyLoss(const R3BTrackingParticle* particle)
+Double_t R3BTrackingDetector::GetEnergyLoss(const R3BTrackingParticle* particle, Double_t weight, Bool_t backward)
 {
+#ifdef WITH_ATIMA
+    Double_t tableLoss;
+    if (fEnergyLossTable && fEnergyLossTable->GetEnergyLoss(fEnergyLossIndex, particle, weight, backward, tableLoss))
+    {
+        return tableLoss;
+    }
+#endif
+
     TVector3 mom_track = particle->GetMomentum().Unit();
 
     Double_t Z2 = fGeo->GetZ();
@@ -172,7 +185,7 @@ Double_t R3BTrackingDetector::GetEnergyLoss(const R3BTrackingParticle* particle)
     //        0.5));
     //    }
 
-    return eloss;
+    return weight * eloss;
 }
 
 void R3BTrackingDetector::SetParContainers()
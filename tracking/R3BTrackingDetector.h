@@ -34,6 +34,7 @@ enum EDetectorType
 class R3BHit;
 class TClonesArray;
 class R3BTGeoPar;
+class R3BTrackingEnergyLoss;
 
 /* Generic detector class that holds all infos needed for the track fitting
  */
@@ -59,7 +60,19 @@ class R3BTrackingDetector : public TObject
 
     const TString& GetDetectorName() const { return fDetectorName; }
 
-    Double_t GetEnergyLoss(const R3BTrackingParticle* particle);
+    /* Energy loss [MeV] of the particle in the detector, or in a fraction
+     * (weight) of its thickness. backward: the particle is tracked against
+     * its direction of flight. Taken from the tables of
+     * SetEnergyLossTable() if they know the particle, else from the Bethe
+     * formula. */
+    Double_t GetEnergyLoss(const R3BTrackingParticle* particle, Double_t weight = 1., Bool_t backward = kFALSE);
+
+    /* Energy loss tables and the index of this detector in their setup */
+    void SetEnergyLossTable(const R3BTrackingEnergyLoss* table, Int_t index)
+    {
+        fEnergyLossTable = table;
+        fEnergyLossIndex = index;
+    }
 
     inline R3BTGeoPar* GetGeoPar() { return fGeo; }
 
@@ -82,6 +95,9 @@ class R3BTrackingDetector : public TObject
     // ??
     R3BTGeoPar* fGeo;
 
+    const R3BTrackingEnergyLoss* fEnergyLossTable; //!
+    Int_t fEnergyLossIndex;                        //!
+
     // resolutions (for the chi2)
     Double_t res_x;
     Double_t res_y;
@@ -0,0 +1,309 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#include "R3BTrackingEnergyLoss.h"
+#include "R3BAtimaCache.h"
+#include "R3BTGeoPar.h"
+#include "R3BTrackingDetector.h"
+#include "R3BTrackingParticle.h"
+#include "R3BTrackingSetup.h"
+
+#include "FairLogger.h"
+
+#include "TMath.h"
+
+#include <algorithm>
+
+using namespace std;
+
+#define Amu 0.938272       // as in the fitters, mass = A * Amu
+#define Atima_Amu 931.4941 // MeV, ATIMA energies are per atomic mass unit
+
+namespace
+{
+    // ATIMA needs a thickness, the range does not depend on it
+    const Double_t c_distance_mm = 0.01;
+} // namespace
+
+R3BTrackingEnergyLoss::R3BTrackingEnergyLoss()
+    : fEnergyMin(10.)
+    , fEnergyMax(2000.)
+    , fEnergySteps(1000)
+    , fAirGaps(kTRUE)
+    , fNMaterials(0)
+{
+}
+
+R3BTrackingEnergyLoss::~R3BTrackingEnergyLoss() {}
+
+void R3BTrackingEnergyLoss::AddFragment(Int_t Z, Int_t A)
+{
+    Fragment fragment;
+    fragment.Z = Z;
+    fragment.A = A;
+    fFragments.push_back(fragment);
+}
+
+void R3BTrackingEnergyLoss::SetEnergyRange(Double_t min_MeV_per_u, Double_t max_MeV_per_u, Int_t steps)
+{
+    fEnergyMin = min_MeV_per_u;
+    fEnergyMax = max_MeV_per_u;
+    fEnergySteps = steps;
+}
+
+void R3BTrackingEnergyLoss::Init(R3BTrackingSetup* setup)
+{
+    if (fEnergySteps < 1 || fEnergyMin <= 0. || fEnergyMax <= fEnergyMin)
+    {
+        LOG(FATAL) << "R3BTrackingEnergyLoss: invalid energy range " << fEnergyMin << " - " << fEnergyMax << " MeV/u";
+    }
+
+    // Layers and their materials
+    vector<R3BAtima::TargetMaterial> materials;
+    Int_t air = -1;
+
+    fLayers.clear();
+    fDetectorLayer.clear();
+    fAirLayer.clear();
+
+    const auto& detectors = setup->GetArray();
+    for (size_t i = 0; i < detectors.size(); i++)
+    {
+        R3BTrackingDetector* det = detectors[i];
+        R3BTGeoPar* geo = det->GetGeoPar();
+
+        Int_t airLayer = -1;
+        if (fAirGaps && i > 0 && detectors[i - 1]->section == det->section)
+        {
+            if (air < 0)
+            {
+                air = materials.size();
+                materials.push_back(R3BAtima::TargetMaterial::Air);
+            }
+            Layer layer;
+            layer.name = "air_" + det->GetDetectorName();
+            layer.material = air;
+            layer.thickness_mg_per_cm2 = (det->pos0 - detectors[i - 1]->pos0).Mag() * materials[air].Density * 1e3;
+            airLayer = fLayers.size();
+            fLayers.push_back(layer);
+        }
+
+        // Effective single element material of the detector
+        const R3BAtima::TargetMaterial material(
+            { R3BAtima::MaterialCompound(geo->GetA(), geo->GetZ()) }, geo->GetDensity(), kFALSE);
+        Int_t m = 0;
+        while (m < (Int_t)materials.size() &&
+               (materials[m].IsGas || materials[m].Density != material.Density ||
+                materials[m].Compounds[0] != material.Compounds[0]))
+        {
+            m++;
+        }
+        if (m == (Int_t)materials.size())
+        {
+            materials.push_back(material);
+        }
+
+        Layer layer;
+        layer.name = det->GetDetectorName();
+        layer.material = m;
+        layer.thickness_mg_per_cm2 = 2. * geo->GetDimZ() * geo->GetDensity() * 1e3;
+
+        fAirLayer.push_back(airLayer);
+        fDetectorLayer.push_back(fLayers.size());
+        fLayers.push_back(layer);
+    }
+
+    // Range tables of all fragments in all materials
+    fNMaterials = materials.size();
+    fTables.clear();
+    fTables.resize(fFragments.size() * fNMaterials);
+
+    const Double_t energyStep = (fEnergyMax - fEnergyMin) / fEnergySteps;
+    const Int_t rangeSteps = 4 * fEnergySteps;
+
+    for (size_t f = 0; f < fFragments.size(); f++)
+    {
+        for (Int_t m = 0; m < fNMaterials; m++)
+        {
+            const R3BAtima::Cache::RangeSelector energies = { fEnergyMin, fEnergyMax, fEnergySteps };
+            const R3BAtima::Cache::RangeSelector distances = { c_distance_mm, c_distance_mm, 0 };
+            const auto cache =
+                fCachePath.Length() > 0
+                    ? R3BAtima::Cache(fFragments[f].A, fFragments[f].Z, energies, materials[m], distances, fCachePath)
+                    : R3BAtima::Cache(fFragments[f].A, fFragments[f].Z, energies, materials[m], distances);
+
+            Table& table = fTables[f * fNMaterials + m];
+            table.range.resize(fEnergySteps + 1);
+            for (Int_t i = 0; i <= fEnergySteps; i++)
+            {
+                const Double_t energy = std::min(fEnergyMin + i * energyStep, fEnergyMax);
+                table.range[i] = cache(energy, c_distance_mm).Range_mg_per_cm2;
+                if (i > 0 && table.range[i] <= table.range[i - 1])
+                {
+                    LOG(FATAL) << "R3BTrackingEnergyLoss: range of fragment Z=" << fFragments[f].Z
+                               << " A=" << fFragments[f].A << " does not increase with the energy at " << energy
+                               << " MeV/u";
+                }
+            }
+
+            // Invert on a finer, regular range grid
+            table.rangeMin = table.range.front();
+            table.rangeStep = (table.range.back() - table.range.front()) / rangeSteps;
+            table.energy.resize(rangeSteps + 1);
+            Int_t i = 0;
+            for (Int_t k = 0; k <= rangeSteps; k++)
+            {
+                const Double_t range = table.rangeMin + k * table.rangeStep;
+                while (i < fEnergySteps - 1 && table.range[i + 1] < range)
+                {
+                    i++;
+                }
+                const Double_t t = (range - table.range[i]) / (table.range[i + 1] - table.range[i]);
+                table.energy[k] = fEnergyMin + (i + t) * energyStep;
+            }
+        }
+    }
+
+    for (size_t i = 0; i < detectors.size(); i++)
+    {
+        detectors[i]->SetEnergyLossTable(this, i);
+    }
+
+    LOG(INFO) << "R3BTrackingEnergyLoss: " << fLayers.size() << " layers of " << fNMaterials << " materials, "
+              << fFragments.size() << " fragments";
+}
+
+Int_t R3BTrackingEnergyLoss::FindFragment(Double_t charge, Double_t mass_GeV) const
+{
+    // The backward fits track the particle with the opposite charge
+    const Int_t Z = TMath::Nint(TMath::Abs(charge));
+    const Double_t A = mass_GeV / Amu;
+    Int_t best = -1;
+    for (size_t f = 0; f < fFragments.size(); f++)
+    {
+        if (fFragments[f].Z == Z && (best < 0 || TMath::Abs(fFragments[f].A - A) < TMath::Abs(fFragments[best].A - A)))
+        {
+            best = f;
+        }
+    }
+    return best;
+}
+
+Double_t R3BTrackingEnergyLoss::Range(const Table& table, Double_t energy_MeV_per_u) const
+{
+    if (energy_MeV_per_u <= 0.)
+    {
+        return 0.;
+    }
+    if (energy_MeV_per_u < fEnergyMin)
+    {
+        // Below the table, towards R(0) = 0
+        return table.range.front() * energy_MeV_per_u / fEnergyMin;
+    }
+    // Linear extrapolation above the table
+    const Double_t pos = (energy_MeV_per_u - fEnergyMin) / (fEnergyMax - fEnergyMin) * fEnergySteps;
+    const Int_t i = std::min((Int_t)pos, fEnergySteps - 1);
+    const Double_t t = pos - i;
+    return (1. - t) * table.range[i] + t * table.range[i + 1];
+}
+
+Double_t R3BTrackingEnergyLoss::Energy(const Table& table, Double_t range_mg_per_cm2) const
+{
+    if (range_mg_per_cm2 <= 0.)
+    {
+        // Stopped
+        return 0.;
+    }
+    if (range_mg_per_cm2 < table.rangeMin)
+    {
+        return fEnergyMin * range_mg_per_cm2 / table.rangeMin;
+    }
+    const Double_t pos = (range_mg_per_cm2 - table.rangeMin) / table.rangeStep;
+    const Int_t nSteps = table.energy.size() - 1;
+    const Int_t k = std::min((Int_t)pos, nSteps - 1);
+    const Double_t t = pos - k;
+    return (1. - t) * table.energy[k] + t * table.energy[k + 1];
+}
+
+Double_t R3BTrackingEnergyLoss::GetEnergyAfter(Int_t fragment,
+                                               Int_t layer,
+                                               Double_t energy_MeV_per_u,
+                                               Double_t fraction) const
+{
+    const Table& table = GetTable(fragment, layer);
+    return Energy(table, Range(table, energy_MeV_per_u) - fraction * fLayers[layer].thickness_mg_per_cm2);
+}
+
+Double_t R3BTrackingEnergyLoss::GetEnergyBefore(Int_t fragment,
+                                                Int_t layer,
+                                                Double_t energy_MeV_per_u,
+                                                Double_t fraction) const
+{
+    const Table& table = GetTable(fragment, layer);
+    return Energy(table, Range(table, energy_MeV_per_u) + fraction * fLayers[layer].thickness_mg_per_cm2);
+}
+
+Double_t R3BTrackingEnergyLoss::GetEnergyAfterLayers(Int_t fragment,
+                                                     Int_t first,
+                                                     Int_t n,
+                                                     Double_t energy_MeV_per_u) const
+{
+    for (Int_t layer = first; layer < first + n && energy_MeV_per_u > 0.; layer++)
+    {
+        energy_MeV_per_u = GetEnergyAfter(fragment, layer, energy_MeV_per_u);
+    }
+    return energy_MeV_per_u;
+}
+
+Bool_t R3BTrackingEnergyLoss::GetEnergyLoss(Int_t detector,
+                                            const R3BTrackingParticle* particle,
+                                            Double_t fraction,
+                                            Bool_t backward,
+                                            Double_t& eloss_MeV) const
+{
+    const Int_t fragment = FindFragment(particle->GetCharge(), particle->GetMass());
+    const Double_t beta = particle->GetBeta();
+    if (fragment < 0 || detector < 0 || detector >= (Int_t)fDetectorLayer.size() || beta <= 0. || beta >= 1.)
+    {
+        return kFALSE;
+    }
+
+    // The range in mg/cm2 scales with the mass at a given velocity, the
+    // table of the nearest fragment is used for the actual mass
+    const Double_t scale = fFragments[fragment].A * Amu / particle->GetMass();
+
+    const Double_t energy = (particle->GetGamma() - 1.) * Atima_Amu;
+    const Int_t airLayer = fAirLayer[detector];
+    const Int_t detLayer = fDetectorLayer[detector];
+
+    Double_t e = energy;
+    if (!backward)
+    {
+        if (airLayer >= 0)
+        {
+            e = GetEnergyAfter(fragment, airLayer, e, scale);
+        }
+        e = GetEnergyAfter(fragment, detLayer, e, fraction * scale);
+    }
+    else
+    {
+        e = GetEnergyBefore(fragment, detLayer, e, fraction * scale);
+        if (airLayer >= 0)
+        {
+            e = GetEnergyBefore(fragment, airLayer, e, scale);
+        }
+    }
+
+    eloss_MeV = TMath::Abs(energy - e) * particle->GetMass() * 1e3 / Atima_Amu;
+    return kTRUE;
+}
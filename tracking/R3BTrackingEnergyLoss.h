@@ -0,0 +1,133 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+#ifndef R3B_TRACKING_ENERGYLOSS
+#define R3B_TRACKING_ENERGYLOSS
+
+#include "TString.h"
+
+#include <vector>
+
+class R3BTrackingParticle;
+class R3BTrackingSetup;
+
+/* Energy loss of fragments in the layers of a tracking setup.
+ *
+ * For each fragment and each material in the setup, the range as a
+ * function of the energy is calculated once with ATIMA. The energy behind
+ * a layer then follows from the range reduced by the layer thickness,
+ * E_out = E(R(E_in) - t), with two table lookups. Layers of the same
+ * material share their tables.
+ *
+ * The layers are the detectors of the setup in their order, each preceded
+ * by the air gap to the previous detector if that is in the same section.
+ * After Init() the detectors take their energy loss from here, so the
+ * fitters and the Minuit objective functions use it without changes.
+ * Particles with a charge not added as fragment keep the Bethe formula of
+ * R3BTrackingDetector.
+ */
+class R3BTrackingEnergyLoss
+{
+  public:
+    R3BTrackingEnergyLoss();
+    virtual ~R3BTrackingEnergyLoss();
+
+    void AddFragment(Int_t Z, Int_t A);
+
+    /* Energy range and number of steps of the tables [MeV/u] */
+    void SetEnergyRange(Double_t min_MeV_per_u, Double_t max_MeV_per_u, Int_t steps);
+
+    /* Whether to add the air between the detectors, kTRUE by default */
+    void SetAirGaps(Bool_t airGaps) { fAirGaps = airGaps; }
+
+    /* Directory for the ATIMA cache files, see R3BAtima::Cache */
+    void SetCachePath(const TString& path) { fCachePath = path; }
+
+    /* Calculates the tables and attaches them to the detectors.
+     * The detectors have to be initialised already. */
+    void Init(R3BTrackingSetup* setup);
+
+    Int_t GetNLayers() const { return fLayers.size(); }
+    const TString& GetLayerName(Int_t layer) const { return fLayers.at(layer).name; }
+    Double_t GetLayerThickness(Int_t layer) const { return fLayers.at(layer).thickness_mg_per_cm2; }
+
+    /* Index of the fragment with the given charge and mass nearest to the
+     * given one, -1 if there is none. The sign of the charge is ignored. */
+    Int_t FindFragment(Double_t charge, Double_t mass_GeV) const;
+
+    /* Energy behind / in front of a layer or a fraction of it [MeV/u] */
+    Double_t GetEnergyAfter(Int_t fragment, Int_t layer, Double_t energy_MeV_per_u, Double_t fraction = 1.) const;
+    Double_t GetEnergyBefore(Int_t fragment, Int_t layer, Double_t energy_MeV_per_u, Double_t fraction = 1.) const;
+
+    /* Energy behind the layers first ... first + n - 1 [MeV/u] */
+    Double_t GetEnergyAfterLayers(Int_t fragment, Int_t first, Int_t n, Double_t energy_MeV_per_u) const;
+
+    /* Energy loss [MeV] of a particle in a detector of the setup and the air
+     * gap in front of it. detector: index in the setup, fraction: part of
+     * the detector thickness, backward: the particle is tracked against its
+     * direction of flight.
+     * Returns kFALSE if the particle is no known fragment. */
+    Bool_t GetEnergyLoss(Int_t detector,
+                         const R3BTrackingParticle* particle,
+                         Double_t fraction,
+                         Bool_t backward,
+                         Double_t& eloss_MeV) const;
+
+  private:
+    struct Fragment
+    {
+        Int_t Z;
+        Int_t A;
+    };
+
+    struct Layer
+    {
+        TString name;
+        Int_t material;
+        Double_t thickness_mg_per_cm2;
+    };
+
+    /* Range R(E) on a regular energy grid and its inverse E(R) on a
+     * regular range grid */
+    struct Table
+    {
+        Double_t rangeMin, rangeStep;
+        std::vector<Double_t> range;
+        std::vector<Double_t> energy;
+    };
+
+    Double_t Range(const Table& table, Double_t energy_MeV_per_u) const;
+    Double_t Energy(const Table& table, Double_t range_mg_per_cm2) const;
+
+    const Table& GetTable(Int_t fragment, Int_t layer) const
+    {
+        return fTables[fragment * fNMaterials + fLayers[layer].material];
+    }
+
+    std::vector<Fragment> fFragments;
+    Double_t fEnergyMin;
+    Double_t fEnergyMax;
+    Int_t fEnergySteps;
+    Bool_t fAirGaps;
+    TString fCachePath;
+
+    std::vector<Layer> fLayers;
+    // Per detector of the setup: its layer and the air gap in front of it, or -1
+    std::vector<Int_t> fDetectorLayer;
+    std::vector<Int_t> fAirLayer;
+
+    Int_t fNMaterials;
+    std::vector<Table> fTables;
+};
+
+#endif
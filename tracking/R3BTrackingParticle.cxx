@@ -81,7 +81,7 @@ R3BTrackingParticle::~R3BTrackingParticle() {}
 
 void R3BTrackingParticle::PassThroughDetector(R3BTrackingDetector* det, Double_t weight)
 {
-    Double_t eloss = weight * det->GetEnergyLoss(this) * 1e-3;
+    Double_t eloss = det->GetEnergyLoss(this, weight) * 1e-3;
     fBeta = fBeta - DeltaEToDeltaBeta(eloss);
     //    UpdateMomentum();
     Double_t mom = fMomentum.Mag();
@@ -92,7 +92,7 @@ void R3BTrackingParticle::PassThroughDetector(R3BTrackingDetector* det, Double_t
 
 void R3BTrackingParticle::PassThroughDetectorBackward(R3BTrackingDetector* det, Double_t weight)
 {
-    Double_t eloss = weight * det->GetEnergyLoss(this) * 1e-3;
+    Double_t eloss = det->GetEnergyLoss(this, weight, kTRUE) * 1e-3;
     fBeta = fBeta + DeltaEToDeltaBeta(eloss);
     //    UpdateMomentum();
     Double_t mom = fMomentum.Mag();
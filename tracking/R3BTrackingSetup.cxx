@@ -48,15 +48,17 @@ void R3BTrackingSetup::AddDetector(const string& name,
     fMapIndex[name] = index;
 }
 
-R3BTrackingDetector* R3BTrackingSetup::GetByName(const string& name)
+R3BTrackingDetector* R3BTrackingSetup::GetByName(const string& name) const
 {
-    if (fMapIndex.find(name) == fMapIndex.end())
+    // Only const accesses, this is called concurrently by the fits
+    const auto it = fMapIndex.find(name);
+    if (it == fMapIndex.end())
     {
         LOG(ERROR) << "Detector " << name << " was not found in setup.";
         return nullptr;
     }
 
-    return fDetectors.at(fMapIndex[name]);
+    return fDetectors.at(it->second);
 }
 
 R3BTrackingDetector* R3BTrackingSetup::GetFirstByType(const EDetectorType& type)
@@ -30,7 +30,7 @@ class R3BTrackingSetup
                      const std::string& geoParName,
                      const std::string& dataName = "");
 
-    R3BTrackingDetector* GetByName(const std::string& name);
+    R3BTrackingDetector* GetByName(const std::string& name) const;
 
     R3BTrackingDetector* GetFirstByType(const EDetectorType& type);
 
@@ -42,7 +42,7 @@ class R3BTrackingSetup
 
     std::vector<R3BTrackingDetector*>& GetArray() { return fDetectors; }
 
-    R3BHit* GetHit(const std::string& detName, const Int_t& hitId) { return GetByName(detName)->hits[hitId]; }
+    R3BHit* GetHit(const std::string& detName, const Int_t& hitId) const { return GetByName(detName)->hits[hitId]; }
 
     Double_t GetAfterGladResolution();
 
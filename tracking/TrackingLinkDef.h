@@ -27,6 +27,9 @@
 #pragma link C++ class R3BTrackingDetector+;
 #pragma link C++ class R3BTrackingParticle+;
 #pragma link C++ class R3BTrackingSetup+;
+#ifdef WITH_ATIMA
+#pragma link C++ class R3BTrackingEnergyLoss+;
+#endif
 
 #endif
 
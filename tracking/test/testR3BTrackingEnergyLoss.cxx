@@ -0,0 +1,60 @@
+/******************************************************************************
+ *   Copyright (C) 2019 GSI Helmholtzzentrum für Schwerionenforschung GmbH    *
+ *   Copyright (C) 2019 Members of R3B Collaboration                          *
+ *                                                                            *
+ *             This software is distributed under the terms of the            *
+ *                 GNU General Public Licence (GPL) version 3,                *
+ *                    copied verbatim in the file "LICENSE".                  *
+ *                                                                            *
+ * In applying this license GSI does not waive the privileges and immunities  *
+ * granted to it by virtue of its status as an Intergovernmental Organization *
+ * or submit itself to any jurisdiction.                                      *
+ ******************************************************************************/
+
+
+#include "R3BTGeoPar.h"
+#include "R3BTrackingDetector.h"
+#include "R3BTrackingEnergyLoss.h"
+#include "R3BTrackingParticle.h"
+#include "R3BTrackingSetup.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+    const Double_t amu = 0.938272;
+
+    TEST(testR3BTrackingEnergyLoss, chargeSign)
+    {
+        // One carbon layer, 1 mm thick
+        R3BTGeoPar geo("testGeoPar");
+        geo.SetDimXYZ(10., 10., 0.05);
+        geo.SetMaterial(6., 12., 2., 78.e-6);
+
+        R3BTrackingSetup setup;
+        auto det = new R3BTrackingDetector("test", kAfterGlad, "testGeoPar");
+        det->fGeo = &geo;
+        setup.GetArray().push_back(det);
+
+        R3BTrackingEnergyLoss energyLoss;
+        energyLoss.AddFragment(50, 132);
+        energyLoss.SetEnergyRange(100., 1000., 90);
+        energyLoss.Init(&setup);
+
+        // The backward fits negate the charge of the candidate
+        const R3BTrackingParticle forward(50., 0., 0., 0., 0., 0., 1., 0.7, 132. * amu);
+        const R3BTrackingParticle backward(-50., 0., 0., 0., 0., 0., 1., 0.7, 132. * amu);
+        EXPECT_EQ(energyLoss.FindFragment(50., 132. * amu), 0);
+        EXPECT_EQ(energyLoss.FindFragment(-50., 132. * amu), 0);
+        EXPECT_EQ(energyLoss.FindFragment(49., 132. * amu), -1);
+
+        Double_t lossForward, lossBackward;
+        ASSERT_TRUE(energyLoss.GetEnergyLoss(0, &forward, 1., kFALSE, lossForward));
+        ASSERT_TRUE(energyLoss.GetEnergyLoss(0, &backward, 1., kFALSE, lossBackward));
+        EXPECT_GT(lossForward, 0.);
+        EXPECT_EQ(lossBackward, lossForward);
+
+        // The detector takes the loss of the negated particle from the table
+        EXPECT_EQ(det->GetEnergyLoss(&backward), lossBackward);
+    }
+} // namespace